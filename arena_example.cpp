@@ -0,0 +1,69 @@
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <vector>
+
+#include "stack_arena.hpp"
+
+int main() {
+    // One stack block shared by a whole per-request working set
+    StackArena<8192> arena;
+
+    // Example 1: Several containers allocating from the same arena
+    std::cout << "Example 1: Vector, list and map sharing one arena\n";
+    {
+        std::vector<int, ArenaAllocator<int>> ids{ArenaAllocator<int>{arena}};
+        ids.reserve(16);
+        for (int i = 0; i < 16; ++i) {
+            ids.push_back(i * 3);
+        }
+
+        std::list<int, ArenaAllocator<int>> pending{ArenaAllocator<int>{arena}};
+        pending.push_back(1);
+        pending.push_back(2);
+        pending.push_back(3);
+
+        using MapAlloc = ArenaAllocator<std::pair<const int, int>>;
+        std::map<int, int, std::less<int>, MapAlloc> index{MapAlloc{arena}};
+        for (int id : ids) {
+            index[id] = id * id;
+        }
+
+        std::cout << "ids: " << ids.size() << ", pending: " << pending.size()
+                  << ", index: " << index.size() << "\n";
+        std::cout << "index[9] = " << index[9] << "\n";
+        std::cout << "Arena used: " << arena.used() << " of " << arena.capacity() << " bytes\n";
+    }
+
+    // Example 2: Releasing the whole working set in one step
+    std::cout << "\nExample 2: Reset\n";
+    arena.reset();
+    std::cout << "Arena used after reset: " << arena.used() << " bytes\n";
+
+    // Example 3: Per-token scratch data dropped by a checkpoint scope
+    std::cout << "\nExample 3: RewindScope per token\n";
+    const char* tokens[] = {"let", "x", "=", "42"};
+    for (const char* token : tokens) {
+        RewindScope scope{arena};
+        std::vector<char, ArenaAllocator<char>> scratch{ArenaAllocator<char>{arena}};
+        scratch.reserve(32);
+        for (const char* c = token; *c != '\0'; ++c) {
+            scratch.push_back(*c);
+        }
+        std::cout << "token '" << token << "' used " << arena.used() << " bytes\n";
+    }
+    std::cout << "Arena used after all tokens: " << arena.used() << " bytes\n";
+
+    // Example 4: Borrowing an existing buffer
+    std::cout << "\nExample 4: Borrowed buffer\n";
+    alignas(std::max_align_t) char buffer[256];
+    ArenaResource borrowed{buffer, sizeof(buffer)};
+    std::vector<double, ArenaAllocator<double>> values{ArenaAllocator<double>{borrowed}};
+    values.reserve(8);
+    values.push_back(3.14);
+    std::cout << "Borrowed arena used: " << borrowed.used() << " bytes, owns data: " << std::boolalpha
+              << borrowed.owns(values.data()) << "\n";
+
+    return 0;
+}
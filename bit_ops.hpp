@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/// Defined when SSE2 intrinsics are available (always on x86-64)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STACK_VEC_SSE2 1
+#endif
+
+/**
+ * @brief Bit scan and population count helpers
+ *
+ * Each maps to a single instruction (BSF/TZCNT, BSR/LZCNT, POPCNT) on the compilers the
+ * containers support. Shared by the flat and hash maps (SSE2 match masks), StackBitset
+ * and the TLSF arena (free-list bitmaps).
+ */
+namespace bit_internal {
+
+/// Number of set bits in a word (a single POPCNT where the target has it)
+inline unsigned popcount(std::uint64_t word) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    return static_cast<unsigned>(__popcnt64(word));
+#elif defined(_MSC_VER) && !defined(__clang__)
+    return __popcnt(static_cast<unsigned>(word)) + __popcnt(static_cast<unsigned>(word >> 32));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+}
+
+/// Index of the lowest set bit of a non-zero word
+inline unsigned lowest_bit(std::uint64_t word) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, word);
+    return static_cast<unsigned>(idx);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    if (_BitScanForward(&idx, static_cast<unsigned long>(word))) {
+        return static_cast<unsigned>(idx);
+    }
+    _BitScanForward(&idx, static_cast<unsigned long>(word >> 32));
+    return static_cast<unsigned>(idx) + 32;
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+/// Index of the highest set bit of a non-zero word
+inline unsigned highest_bit(std::uint64_t word) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanReverse64(&idx, word);
+    return static_cast<unsigned>(idx);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    if (_BitScanReverse(&idx, static_cast<unsigned long>(word >> 32))) {
+        return static_cast<unsigned>(idx) + 32;
+    }
+    _BitScanReverse(&idx, static_cast<unsigned long>(word));
+    return static_cast<unsigned>(idx);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(word));
+#endif
+}
+
+}  // namespace bit_internal
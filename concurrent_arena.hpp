@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "stack_arena.hpp"
+
+/**
+ * @brief Bump arena that many threads can allocate from concurrently
+ *
+ * The offset is advanced with a single atomic fetch-add, so any number of producer
+ * threads can carve blocks out of one pre-sized region without a lock. Every block is
+ * rounded up to Granularity bytes, which keeps all blocks Granularity-aligned without a
+ * compare-and-swap loop. When the region is full, fetch-add pushes the offset past the
+ * end and the losing allocation simply returns nullptr; the offset is never rolled back.
+ *
+ * @tparam Granularity Block size step and alignment in bytes (power of two)
+ *
+ * Example usage:
+ * @code
+ * ConcurrentStackArena<1 << 20> log_buffer;
+ * // on any producer thread
+ * if (void* rec = log_buffer.allocate(sizeof(Record))) {
+ *     new (rec) Record{...};
+ * } else {
+ *     dropped.fetch_add(1, std::memory_order_relaxed);
+ * }
+ * @endcode
+ *
+ * @note This class does not throw exceptions; allocation failures return nullptr.
+ *       Overflow is an expected condition here and does not assert.
+ * @note reset() and rewind() must not race with allocations
+ */
+template <std::size_t Granularity = alignof(std::max_align_t)>
+class ConcurrentArenaResource {
+    static_assert((Granularity & (Granularity - 1)) == 0, "Granularity must be a power of two");
+
+   public:
+    using size_type = std::size_t;
+
+    static_assert(std::atomic<size_type>::is_always_lock_free,
+                  "ConcurrentArenaResource requires a lock-free atomic offset");
+
+    /// Default alignment for allocations that do not specify one
+    static constexpr size_type default_alignment = Granularity;
+
+    /**
+     * @brief Construct an arena over an existing buffer
+     *
+     * @param buffer Start of the buffer to allocate from
+     * @param size Size of the buffer in bytes
+     */
+    ConcurrentArenaResource(void* buffer, size_type size) noexcept
+        : m_begin(static_cast<char*>(buffer)), m_size(size), m_start(0), m_offset(0) {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_begin);
+        m_start = stack_alloc_internal::align_up(base, Granularity) - base;
+        m_offset.store(m_start, std::memory_order_relaxed);
+    }
+
+    ConcurrentArenaResource(const ConcurrentArenaResource&) = delete;
+    ConcurrentArenaResource& operator=(const ConcurrentArenaResource&) = delete;
+
+    /**
+     * @brief Allocate bytes with the given alignment (thread-safe, lock-free)
+     *
+     * Alignments above Granularity are satisfied by over-allocating the block.
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the returned pointer, must be a power of two
+     * @return Pointer to the allocated memory, or nullptr if the region is exhausted
+     */
+    void* allocate(size_type bytes, size_type align = default_alignment) noexcept {
+        size_type rounded = stack_alloc_internal::align_up(bytes, Granularity);
+        if (align > Granularity) {
+            rounded += align - Granularity;
+        }
+        // Reject impossible requests up front so the offset cannot wrap around
+        if (rounded > m_size) {
+            return nullptr;
+        }
+
+        const size_type start = m_offset.fetch_add(rounded, std::memory_order_relaxed);
+        if (start > m_size || rounded > m_size - start) {
+            return nullptr;
+        }
+
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_begin);
+        return m_begin + (stack_alloc_internal::align_up(base + start, align) - base);
+    }
+
+    /**
+     * @brief Return memory to the arena (thread-safe, lock-free)
+     *
+     * Best effort: the block is reclaimed only if it is still the most recent allocation,
+     * checked with a single compare-and-swap. Over-aligned blocks are never reclaimed.
+     *
+     * @param p Pointer returned by allocate()
+     * @param bytes Size passed to allocate()
+     * @param align Alignment passed to allocate()
+     */
+    void deallocate(void* p, size_type bytes, size_type align = default_alignment) noexcept {
+        if (align > Granularity) {
+            // The block start was shifted for alignment and cannot be recovered; keep it
+            return;
+        }
+        const size_type start = static_cast<size_type>(static_cast<char*>(p) - m_begin);
+        size_type expected = start + stack_alloc_internal::align_up(bytes, Granularity);
+        m_offset.compare_exchange_strong(expected, start, std::memory_order_relaxed);
+    }
+
+    /** @brief Record the current allocation offset */
+    size_type mark() const noexcept { return m_offset.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Release everything allocated since mark()
+     * @warning Must not race with allocations
+     */
+    void rewind(size_type marker) noexcept { m_offset.store(marker, std::memory_order_relaxed); }
+
+    /**
+     * @brief Release every allocation at once
+     * @warning Must not race with allocations
+     */
+    void reset() noexcept { m_offset.store(m_start, std::memory_order_relaxed); }
+
+    /** @brief Get number of bytes handed out (capped at capacity after overflow) */
+    size_type used() const noexcept {
+        const size_type offset = m_offset.load(std::memory_order_relaxed);
+        return (offset < m_size ? offset : m_size) - m_start;
+    }
+    /** @brief Get total size of the buffer in bytes */
+    size_type capacity() const noexcept { return m_size; }
+    /** @brief Check whether an allocation has failed because the region is full */
+    bool exhausted() const noexcept { return m_offset.load(std::memory_order_relaxed) > m_size; }
+
+   private:
+    /// Start of the borrowed buffer
+    char* m_begin;
+    /// Size of the buffer in bytes
+    size_type m_size;
+    /// First Granularity-aligned offset in the buffer
+    size_type m_start;
+    /// Shared offset for next allocation, may run past m_size on overflow
+    std::atomic<size_type> m_offset;
+};
+
+/**
+ * @brief Concurrent arena that holds its own N-byte buffer inline
+ *
+ * @tparam N The size of the buffer in bytes
+ * @tparam Granularity Block size step and alignment in bytes
+ */
+template <std::size_t N, std::size_t Granularity = alignof(std::max_align_t)>
+class ConcurrentStackArena : public ConcurrentArenaResource<Granularity> {
+   public:
+    /** @brief Construct an empty arena over the inline buffer */
+    ConcurrentStackArena() noexcept : ConcurrentArenaResource<Granularity>(m_buffer, N) {}
+
+   private:
+    /// Inline buffer, aligned to the block granularity
+    alignas(Granularity) unsigned char m_buffer[N];
+};
+
+/**
+ * @brief Allocator handle bound to a ConcurrentArenaResource
+ *
+ * @tparam T The type of objects to allocate
+ * @tparam Granularity Block size step and alignment in bytes
+ */
+template <typename T, std::size_t Granularity = alignof(std::max_align_t)>
+using ConcurrentArenaAllocator = ArenaAllocator<T, ConcurrentArenaResource<Granularity>>;
@@ -0,0 +1,52 @@
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "concurrent_arena.hpp"
+
+struct LogRecord {
+    int thread;
+    int sequence;
+    char text[48];
+};
+
+int main() {
+    // Example 1: Many producers filling one pre-sized region without a lock
+    std::cout << "Example 1: Fan-in log buffer\n";
+    ConcurrentStackArena<64 * 1024> log_buffer;
+    std::atomic<int> written{0};
+    std::atomic<int> dropped{0};
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 8; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i) {
+                void* slot = log_buffer.allocate(sizeof(LogRecord), alignof(LogRecord));
+                if (slot == nullptr) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                auto* rec = new (slot) LogRecord{t, i, {}};
+                std::snprintf(rec->text, sizeof(rec->text), "producer %d event %d", t, i);
+                written.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& p : producers) {
+        p.join();
+    }
+
+    std::cout << "Written: " << written.load() << ", dropped: " << dropped.load() << "\n";
+    std::cout << "Used: " << log_buffer.used() << " of " << log_buffer.capacity()
+              << " bytes, exhausted: " << std::boolalpha << log_buffer.exhausted() << "\n\n";
+
+    // Example 2: Reset between flushes
+    std::cout << "Example 2: Reset after flush\n";
+    log_buffer.reset();
+    std::cout << "Used after reset: " << log_buffer.used() << " bytes\n";
+
+    return 0;
+}
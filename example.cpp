@@ -1,12 +1,21 @@
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <new>
+#include <string>
 #include <vector>
 
 #include "stack_allocator.hpp"
 
+// Overflow handler for Example 12; it only reports the request
+static void log_overflow(std::size_t bytes) {
+    std::cout << "overflow handler: " << bytes << " bytes requested\n";
+}
+
 int main() {
-    // Example 1: Using StackVector helper class (unaligned, default)
-    std::cout << "Example 1: Using StackVector (unaligned access)\n";
-    StackVector<int, 10> stack_vec;  // AlignAccess defaults to false
+    // Example 1: Using StackVector helper class
+    std::cout << "Example 1: Using StackVector\n";
+    StackVector<int, 10> stack_vec;  // buffer aligned for int
 
     for (int i = 0; i < 5; ++i) {
         stack_vec.push_back(i * 10);
@@ -18,9 +27,9 @@ int main() {
     }
     std::cout << "\nSize: " << stack_vec.size() << "\n\n";
 
-    // Example 2: Using StackVector with aligned access
-    std::cout << "Example 2: Using StackVector (aligned access)\n";
-    StackVector<int, 10, true> aligned_vec;  // AlignAccess = true
+    // Example 2: Using StackVector with AlignAccess (same layout, kept for compatibility)
+    std::cout << "Example 2: Using StackVector (AlignAccess = true)\n";
+    StackVector<int, 10, true> aligned_vec;
 
     for (int i = 0; i < 5; ++i) {
         aligned_vec.push_back(i * 20);
@@ -60,12 +69,13 @@ int main() {
     std::cout << "Small vec size: " << small_vec.size() << "\n";
     std::cout << "Note: Attempting to exceed capacity will assert in debug builds\n\n";
 
-    // Example 5: Using insert_range with array (integer types only)
-    std::cout << "Example 5: Batch insert with insert_range (integer types)\n";
+    // Example 5: Using insert_range with array (one memcpy for trivially copyable types)
+    std::cout << "Example 5: Batch insert with insert_range\n";
     StackVector<int, 20> batch_vec;
 
     int data[] = {10, 20, 30, 40, 50};
     batch_vec.insert_range(data, 5);  // Insert all 5 elements at once
+    batch_vec.insert_range(BufferView{data, 2});  // Views over mutable data work too
 
     std::cout << "Batch inserted contents: ";
     for (const auto& val : batch_vec) {
@@ -91,7 +101,111 @@ int main() {
     for (const auto& val : fill_vec) {
         std::cout << val << " ";
     }
-    std::cout << "\nSize: " << fill_vec.size() << "\n";
+    std::cout << "\nSize: " << fill_vec.size() << "\n\n";
+
+    // Example 8: Move and swap relocate elements into the destination buffer
+    std::cout << "Example 8: Move and swap\n";
+    StackVector<int, 10> moved_vec(std::move(init_vec));
+    StackVector<int, 10> other_vec = {1, 2};
+    moved_vec.swap(other_vec);
+
+    std::cout << "Moved-from size: " << init_vec.size() << "\n";
+    std::cout << "After swap: ";
+    for (const auto& val : moved_vec) {
+        std::cout << val << " ";
+    }
+    std::cout << "| ";
+    for (const auto& val : other_vec) {
+        std::cout << val << " ";
+    }
+    std::cout << "\nsizeof(StackVector<int, 10>): " << sizeof(StackVector<int, 10>) << " bytes\n\n";
+
+    // Example 9: Over-aligned buffer for SIMD kernels
+    std::cout << "Example 9: 64-byte aligned buffer for SIMD loads\n";
+    StackVector<float, 64, false, 64> samples(64, 0.5f);
+
+    const auto address = reinterpret_cast<std::uintptr_t>(samples.data());
+    std::cout << "Alignment: " << samples.alignment << ", data() % 64 = " << (address % 64)
+              << "\n";
+
+    // Example 10: Filling uninitialized space directly (e.g. from recv() or a decoder)
+    std::cout << "\nExample 10: append_uninitialized / resize_uninitialized\n";
+    StackVector<char, 64> packet;
+    auto tail = packet.append_uninitialized(32);
+    const char payload[] = "hello";
+    std::memcpy(tail.begin(), payload, sizeof(payload) - 1);  // producer wrote 5 bytes
+    packet.resize_uninitialized(sizeof(payload) - 1);
+
+    std::cout << "Packet: " << std::string(packet.begin(), packet.end())
+              << ", size: " << packet.size() << "\n";
+
+    // Example 11: Cheap snapshots for rollback
+    std::cout << "\nExample 11: Copy as a snapshot\n";
+    StackVector<int, 16> state = {1, 2, 3};
+    const StackVector<int, 16> snapshot = state;  // one memcpy of 3 ints
+    state.push_back(4);
+    state[0] = 100;
+    std::cout << "Modified size: " << state.size();
+    state = snapshot;  // roll back
+    std::cout << ", after rollback: ";
+    for (const auto& val : state) {
+        std::cout << val << " ";
+    }
+    std::cout << "\n";
+
+    // Example 12: Choosing what happens when the buffer runs out
+    std::cout << "\nExample 12: Overflow policies\n";
+    using SpillAlloc =
+        stack_alloc_internal::StackAllocator<int, 64, true, 0, overflow_policy::Heap>;
+    std::vector<int, SpillAlloc> spill;
+    for (int i = 0; i < 100; ++i) {
+        spill.push_back(i);  // first growth steps use the buffer, the rest the heap
+    }
+    std::cout << "Heap fallback: " << spill.size() << " elements, last " << spill.back()
+              << "\n";
+
+    std::vector<int, SpillAlloc> source;
+    source.push_back(1);                   // lives in source's inline buffer
+    auto moved = std::move(source);        // the allocator copy gets a fresh buffer
+    for (int i = 2; i <= 100; ++i) {
+        moved.push_back(i);                // reallocation leaves source's block alone
+    }
+    std::cout << "Moved vector: " << moved.size() << " elements, last " << moved.back() << "\n";
+
+    using StrictAlloc =
+        stack_alloc_internal::StackAllocator<int, 64, true, 0, overflow_policy::Throw>;
+    std::vector<int, StrictAlloc> strict;
+    try {
+        strict.reserve(100);
+    } catch (const std::bad_alloc&) {
+        std::cout << "Throw policy: reserve(100) raised std::bad_alloc\n";
+    }
+
+    using LoggedAlloc = stack_alloc_internal::StackAllocator<int, 64, true, 0,
+                                                             overflow_policy::Call<log_overflow>>;
+    std::vector<int, LoggedAlloc> logged;
+    try {
+        logged.reserve(100);  // the handler only logs, so the policy throws after it
+    } catch (const std::bad_alloc&) {
+        std::cout << "Call policy: handler returned, std::bad_alloc raised\n";
+    }
+
+    // Example 13: Embedding vectors in a struct next to small fields
+    std::cout << "\nExample 13: Vectors embedded after a char\n";
+    struct Message {
+        char tag;
+        StackVector<std::string, 4> fields;  // aligned for std::string, not packed after tag
+        StackVector<double, 4> values;
+    };
+    Message msg{'m', {}, {}};
+    msg.fields.emplace_back("symbol");
+    msg.fields.emplace_back("a field long enough to leave the small-string buffer");
+    msg.values.push_back(101.25);
+    const auto fields_address = reinterpret_cast<std::uintptr_t>(msg.fields.data());
+    const auto values_address = reinterpret_cast<std::uintptr_t>(msg.values.data());
+    std::cout << "fields " << msg.fields.size() << ", data() % alignof(std::string) = "
+              << fields_address % alignof(std::string) << ", values data() % alignof(double) = "
+              << values_address % alignof(double) << "\n";
 
     return 0;
 }
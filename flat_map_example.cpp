@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "stack_flat_map.hpp"
+
+int main() {
+    // Example 1: Sorted map with integer keys (vectorized lookups)
+    std::cout << "Example 1: StackFlatMap\n";
+    StackFlatMap<std::uint32_t, float, 64> weights;
+    weights.insert(42, 0.5f);
+    weights.insert(7, 1.5f);
+    weights.insert(19, 2.5f);
+    weights[3] = 4.0f;
+
+    if (float* w = weights.find(19)) {
+        *w *= 2;
+    }
+    std::cout << "Entries in key order: ";
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        std::cout << weights.key_at(i) << "=" << weights.value_at(i) << " ";
+    }
+    std::cout << "\ncontains(8): " << std::boolalpha << weights.contains(8) << "\n\n";
+
+    // Example 2: Unsorted map, O(1) erase
+    std::cout << "Example 2: StackUnorderedFlatMap\n";
+    StackUnorderedFlatMap<std::int64_t, std::string, 16> names;
+    names.try_emplace(1001, "alice");
+    names.try_emplace(1002, "bob");
+    names.try_emplace(1003, "carol");
+    names.erase(1001);
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        std::cout << names.key_at(i) << " -> " << names.value_at(i) << "\n";
+    }
+    std::cout << "\n";
+
+    // Example 3: Sets
+    std::cout << "Example 3: StackFlatSet and StackUnorderedFlatSet\n";
+    StackFlatSet<std::uint16_t, 32> ports;
+    for (std::uint16_t p : {443, 80, 8080, 80, 22}) {
+        ports.insert(p);
+    }
+    std::cout << "Sorted ports: ";
+    for (auto p : ports) {
+        std::cout << p << " ";
+    }
+
+    StackUnorderedFlatSet<std::uint8_t, 32> seen;
+    for (std::uint8_t b : {3, 1, 3, 2, 1}) {
+        seen.insert(b);
+    }
+    std::cout << "\nDistinct bytes seen: " << seen.size() << "\n\n";
+
+    // Example 4: Full tables reject inserts instead of growing
+    std::cout << "Example 4: Capacity\n";
+    StackFlatMap<int, int, 2> tiny;
+    tiny.insert(1, 1);
+    tiny.insert(2, 2);
+    std::cout << "Insert into full map succeeded: " << tiny.insert(3, 3).second << "\n";
+
+    return 0;
+}
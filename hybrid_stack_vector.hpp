@@ -0,0 +1,369 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "stack_allocator.hpp"
+
+/**
+ * @brief Vector with N inline elements that spills to the heap on overflow
+ *
+ * Small-vector sibling of StackVector: the first N elements live directly in the
+ * object, and growing past N moves all elements to a heap buffer that doubles in
+ * size as needed. Unlike StackVector, exceeding the inline capacity is not an error.
+ *
+ * @tparam T The type of elements in the vector
+ * @tparam N The number of elements stored inline
+ *
+ * Example usage:
+ * @code
+ * HybridStackVector<Request, 16> batch;
+ * for (auto& r : incoming) {
+ *     batch.push_back(r);  // never fails; heap only for batches over 16
+ * }
+ * if (batch.spilled()) {
+ *     ++oversized_batches;
+ * }
+ * @endcode
+ *
+ * @note Copies allocate only when the copied elements do not fit inline
+ * @note Heap growth uses std::allocator<T> and may throw std::bad_alloc
+ * @note Like std::vector, growth copies elements whose move constructor may throw, so a
+ *       failed push_back or reserve leaves the vector unchanged
+ * @note Once spilled, clear() keeps the heap buffer; call shrink_to_fit() to return inline
+ */
+template <typename T, std::size_t N>
+class HybridStackVector {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Default constructor
+     *
+     * Creates an empty vector using the inline buffer.
+     */
+    HybridStackVector() noexcept : m_heap(nullptr), m_size(0), m_heap_capacity(0) {}
+
+    /**
+     * @brief Constructor from initializer list
+     *
+     * Spills to the heap immediately if the list is longer than N.
+     *
+     * @param init Initializer list of elements
+     */
+    HybridStackVector(std::initializer_list<T> init) : HybridStackVector() {
+        reserve(init.size());
+        for (const T& value : init) {
+            emplace_back(value);
+        }
+    }
+
+    /**
+     * @brief Constructor to fill with n copies of value
+     *
+     * @param count Number of elements to create
+     * @param value Value to copy into each element
+     */
+    HybridStackVector(std::size_t count, const T& value) : HybridStackVector() {
+        reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            emplace_back(value);
+        }
+    }
+
+    /**
+     * @brief Copy constructor
+     *
+     * Copies the live elements (one memcpy for trivially copyable types). The copy
+     * stays inline when other's elements fit in N, even if other has spilled.
+     */
+    HybridStackVector(const HybridStackVector& other) : HybridStackVector() {
+        reserve(other.m_size);
+        stack_alloc_internal::copy_n(data(), other.data(), other.m_size);
+        m_size = other.m_size;
+    }
+
+    /**
+     * @brief Copy assignment
+     *
+     * Destroys the current elements and copies other's, reusing the current buffer
+     * when it is large enough.
+     */
+    HybridStackVector& operator=(const HybridStackVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.m_size);
+            stack_alloc_internal::copy_n(data(), other.data(), other.m_size);
+            m_size = other.m_size;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move constructor
+     *
+     * Steals the heap buffer if other has spilled, otherwise relocates the inline
+     * elements. Leaves other empty and inline.
+     */
+    HybridStackVector(HybridStackVector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+        : HybridStackVector() {
+        take(other);
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * Releases the current contents, then takes over other's elements as in the
+     * move constructor.
+     */
+    HybridStackVector& operator=(HybridStackVector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            release_heap();
+            take(other);
+        }
+        return *this;
+    }
+
+    /// Destroys all elements and releases the heap buffer, if any
+    ~HybridStackVector() {
+        clear();
+        release_heap();
+    }
+
+    /** @brief Exchange contents with another HybridStackVector */
+    void swap(HybridStackVector& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        HybridStackVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    /** @brief Add element to the end (copy) */
+    void push_back(const T& value) { emplace_back(value); }
+
+    /** @brief Add element to the end (move) */
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    /**
+     * @brief Construct element in-place at the end
+     *
+     * Spills to (or grows) the heap buffer when the current capacity is exhausted.
+     * Arguments may refer to existing elements.
+     *
+     * @tparam Args Types of arguments to forward to T's constructor
+     * @param args Arguments to forward to T's constructor
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == capacity()) {
+            return grow_and_emplace(std::forward<Args>(args)...);
+        }
+        T* slot = ::new (static_cast<void*>(data() + m_size)) T(std::forward<Args>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    /** @brief Remove the last element (must not be empty) */
+    void pop_back() noexcept {
+        assert(m_size > 0 && "HybridStackVector: pop_back on empty vector");
+        --m_size;
+        stack_alloc_internal::destroy_n(data() + m_size, 1);
+    }
+
+    /**
+     * @brief Ensure capacity for at least n elements
+     *
+     * Spills to the heap if n exceeds the current capacity.
+     */
+    void reserve(std::size_t n) {
+        if (n > capacity()) {
+            reallocate(n);
+        }
+    }
+
+    /**
+     * @brief Move elements back inline if they fit, otherwise trim the heap buffer
+     */
+    void shrink_to_fit() {
+        if (m_heap == nullptr) {
+            return;
+        }
+        if (m_size <= N) {
+            T* old = m_heap;
+            const size_type old_capacity = m_heap_capacity;
+            transfer_to(inline_data());
+            m_heap = nullptr;
+            m_heap_capacity = 0;
+            std::allocator<T>().deallocate(old, old_capacity);
+        } else if (m_size < m_heap_capacity) {
+            reallocate(m_size);
+        }
+    }
+
+    /** @brief Access element at index (unchecked) */
+    T& operator[](std::size_t idx) noexcept { return data()[idx]; }
+    /** @brief Access element at index (unchecked, const) */
+    const T& operator[](std::size_t idx) const noexcept { return data()[idx]; }
+
+    /** @brief Access the first element (must not be empty) */
+    T& front() noexcept { return data()[0]; }
+    /** @brief Access the first element (must not be empty, const) */
+    const T& front() const noexcept { return data()[0]; }
+    /** @brief Access the last element (must not be empty) */
+    T& back() noexcept { return data()[m_size - 1]; }
+    /** @brief Access the last element (must not be empty, const) */
+    const T& back() const noexcept { return data()[m_size - 1]; }
+
+    /** @brief Get iterator to beginning */
+    iterator begin() noexcept { return data(); }
+    /** @brief Get iterator to end */
+    iterator end() noexcept { return data() + m_size; }
+    /** @brief Get const iterator to beginning */
+    const_iterator begin() const noexcept { return data(); }
+    /** @brief Get const iterator to end */
+    const_iterator end() const noexcept { return data() + m_size; }
+    /** @brief Get const iterator to beginning */
+    const_iterator cbegin() const noexcept { return data(); }
+    /** @brief Get const iterator to end */
+    const_iterator cend() const noexcept { return data() + m_size; }
+
+    /** @brief Get number of elements */
+    std::size_t size() const noexcept { return m_size; }
+    /** @brief Get current capacity (N while inline, heap capacity once spilled) */
+    std::size_t capacity() const noexcept { return m_heap != nullptr ? m_heap_capacity : N; }
+    /** @brief Get the number of elements that fit inline */
+    static constexpr std::size_t inline_capacity() { return N; }
+    /** @brief Check whether elements currently live on the heap */
+    bool spilled() const noexcept { return m_heap != nullptr; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_size == 0; }
+    /** @brief Remove all elements (keeps any heap buffer) */
+    void clear() noexcept {
+        stack_alloc_internal::destroy_n(data(), m_size);
+        m_size = 0;
+    }
+
+    /** @brief Get pointer to underlying data */
+    T* data() noexcept { return m_heap != nullptr ? m_heap : inline_data(); }
+    /** @brief Get const pointer to underlying data */
+    const T* data() const noexcept { return m_heap != nullptr ? m_heap : inline_data(); }
+
+   private:
+    T* inline_data() noexcept { return reinterpret_cast<T*>(m_storage); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(m_storage); }
+
+    /// Capacity to use when the current one is exhausted
+    size_type next_capacity(size_type needed) const noexcept {
+        const size_type doubled = capacity() * 2;
+        return doubled > needed ? doubled : needed;
+    }
+
+    /// Move all elements into a fresh heap buffer of new_capacity elements
+    void reallocate(size_type new_capacity) {
+        T* fresh = std::allocator<T>().allocate(new_capacity);
+        try {
+            transfer_to(fresh);
+        } catch (...) {
+            std::allocator<T>().deallocate(fresh, new_capacity);
+            throw;
+        }
+        release_heap();
+        m_heap = fresh;
+        m_heap_capacity = new_capacity;
+    }
+
+    /// Slow path of emplace_back: construct into the new buffer before relocating
+    template <typename... Args>
+    T& grow_and_emplace(Args&&... args) {
+        const size_type new_capacity = next_capacity(m_size + 1);
+        T* fresh = std::allocator<T>().allocate(new_capacity);
+        T* slot;
+        try {
+            slot = ::new (static_cast<void*>(fresh + m_size)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<T>().deallocate(fresh, new_capacity);
+            throw;
+        }
+        try {
+            transfer_to(fresh);
+        } catch (...) {
+            slot->~T();
+            std::allocator<T>().deallocate(fresh, new_capacity);
+            throw;
+        }
+        release_heap();
+        m_heap = fresh;
+        m_heap_capacity = new_capacity;
+        ++m_size;
+        return *slot;
+    }
+
+    /// Move the elements into uninitialized dst and destroy the originals. As with
+    /// std::move_if_noexcept, a move that may throw is replaced by a copy, so if this
+    /// throws the elements are untouched and dst holds nothing.
+    void transfer_to(T* dst) {
+        if constexpr (std::is_nothrow_move_constructible<T>::value ||
+                      !std::is_copy_constructible<T>::value) {
+            stack_alloc_internal::relocate_n(dst, data(), m_size);
+        } else {
+            stack_alloc_internal::copy_n(dst, static_cast<const T*>(data()), m_size);
+            stack_alloc_internal::destroy_n(data(), m_size);
+        }
+    }
+
+    /// Free the heap buffer (elements must already be destroyed or relocated)
+    void release_heap() noexcept {
+        if (m_heap != nullptr) {
+            std::allocator<T>().deallocate(m_heap, m_heap_capacity);
+            m_heap = nullptr;
+            m_heap_capacity = 0;
+        }
+    }
+
+    /// Take other's elements; this must be empty and inline
+    void take(HybridStackVector& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (other.m_heap != nullptr) {
+            m_heap = other.m_heap;
+            m_heap_capacity = other.m_heap_capacity;
+            other.m_heap = nullptr;
+            other.m_heap_capacity = 0;
+        } else {
+            stack_alloc_internal::relocate_n(inline_data(), other.inline_data(), other.m_size);
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+
+    /// Inline element storage used until the first spill
+    alignas(T) unsigned char m_storage[N * sizeof(T)];
+    /// Heap buffer once spilled, nullptr while inline
+    T* m_heap;
+    /// Number of constructed elements
+    size_type m_size;
+    /// Capacity of the heap buffer in elements (0 while inline)
+    size_type m_heap_capacity;
+};
+
+/**
+ * @brief Swap two HybridStackVectors
+ */
+template <typename T, std::size_t N>
+void swap(HybridStackVector<T, N>& a, HybridStackVector<T, N>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string>
+
+#include "hybrid_stack_vector.hpp"
+
+int main() {
+    // Example 1: Small batches stay inline
+    std::cout << "Example 1: Inline storage\n";
+    HybridStackVector<int, 16> batch;
+    for (int i = 0; i < 10; ++i) {
+        batch.push_back(i);
+    }
+    std::cout << "Size: " << batch.size() << ", capacity: " << batch.capacity()
+              << ", spilled: " << std::boolalpha << batch.spilled() << "\n\n";
+
+    // Example 2: Growing past the inline capacity spills to the heap
+    std::cout << "Example 2: Spill on overflow\n";
+    for (int i = 10; i < 40; ++i) {
+        batch.push_back(i);
+    }
+    std::cout << "Size: " << batch.size() << ", capacity: " << batch.capacity()
+              << ", spilled: " << batch.spilled() << "\n";
+    std::cout << "Last element: " << batch.back() << "\n\n";
+
+    // Example 3: Shrinking back inline
+    std::cout << "Example 3: shrink_to_fit after clear\n";
+    batch.clear();
+    batch.push_back(7);
+    batch.shrink_to_fit();
+    std::cout << "Size: " << batch.size() << ", spilled: " << batch.spilled() << "\n\n";
+
+    // Example 4: Non-trivial element types and moves
+    std::cout << "Example 4: Moving a spilled vector of strings\n";
+    HybridStackVector<std::string, 2> names = {"alpha", "beta", "gamma"};
+    HybridStackVector<std::string, 2> moved(std::move(names));
+    for (const auto& name : moved) {
+        std::cout << name << " ";
+    }
+    std::cout << "\nMoved-from size: " << names.size() << ", spilled: " << names.spilled()
+              << "\n";
+
+    return 0;
+}
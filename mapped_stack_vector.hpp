@@ -0,0 +1,393 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "buffer_view.hpp"
+#include "mmap_support.hpp"
+#include "stack_allocator.hpp"
+#include "type_signature.hpp"
+
+namespace mapped_internal {
+
+/// "STKVEC" plus a byte-order mark; a file written on the other endianness fails the check
+constexpr std::uint64_t magic = 0x01024345564B5453ULL;
+/// Version of the header layout below
+constexpr std::uint32_t layout_version = 1;
+
+/**
+ * @brief Header at the start of every mapped vector file
+ *
+ * Elements start at data_offset<T>() bytes into the file, directly after the header
+ * padded to a cache line.
+ */
+struct Header {
+    std::uint64_t magic;           ///< mapped_internal::magic
+    std::uint32_t layout_version;  ///< mapped_internal::layout_version
+    std::uint32_t user_version;    ///< Version template argument of the writer
+    std::uint64_t type_hash;       ///< Hash of the element type's name
+    std::uint32_t element_size;    ///< sizeof(T)
+    std::uint32_t element_align;   ///< alignof(T)
+    std::uint64_t size;            ///< Number of live elements
+    std::uint64_t capacity;        ///< Number of element slots in the file
+};
+
+/// Offset of the first element from the start of the file
+template <typename T>
+constexpr std::size_t data_offset() noexcept {
+    return stack_alloc_internal::align_up(sizeof(Header), alignof(T) > 64 ? alignof(T) : 64);
+}
+
+}  // namespace mapped_internal
+
+/**
+ * @brief Fixed-capacity vector of trivially copyable elements stored in a mapped file
+ *
+ * The file is a small header (size, capacity and a fingerprint of T) followed by the
+ * raw element array, mapped MAP_SHARED. Elements are written straight into the page
+ * cache and reopening the file hands them back without parsing or copying: the cost
+ * of loading a prebuilt table is one open and one mmap, and pages are only read from
+ * disk when first touched. Several processes opening the same file read-only share
+ * one copy of it in memory.
+ *
+ * The fingerprint holds sizeof(T), alignof(T), a hash of T's name and the Version
+ * template argument. A file whose fingerprint does not match is left untouched and
+ * the vector reports !valid(). Bump Version whenever T's layout changes without its
+ * name changing.
+ *
+ * @tparam T The type of elements (must be trivially copyable)
+ * @tparam Version Schema version stored in and checked against the file (default: 0)
+ *
+ * Example usage:
+ * @code
+ * MappedStackVector<Entry> table{"table.bin", 1 << 20};
+ * if (!table.valid()) {
+ *     // cannot open, or the file holds a different type
+ * }
+ * if (table.empty()) {
+ *     build(table);       // first run: fill the file
+ *     table.flush();
+ * }
+ * lookup(table[42]);      // later runs: data is already there
+ * @endcode
+ *
+ * @note Failures (open, mmap, a mismatched or truncated file) are reported through
+ *       valid(); nothing throws. An invalid vector is empty with capacity 0.
+ * @note Capacity is fixed when the file is created; pushing past it asserts in debug
+ *       builds
+ * @note The type hash comes from the compiler's spelling of T, so files are portable
+ *       between builds of the same compiler only
+ * @note Requires POSIX mmap; on other platforms valid() is always false
+ * @note Not copyable; moves transfer the mapping
+ */
+template <typename T, std::uint32_t Version = 0>
+class MappedStackVector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedStackVector requires a trivially copyable element type");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Open path for reading and writing, creating it if it does not exist
+     *
+     * An existing file keeps its contents and its own capacity; capacity is only used
+     * when the file is new or empty.
+     *
+     * @param path File to map
+     * @param capacity Number of element slots for a new file
+     */
+    MappedStackVector(const char* path, std::size_t capacity) noexcept
+        : m_mapping(nullptr), m_mapping_size(0), m_read_only(false) {
+        open(path, capacity, false);
+    }
+
+    /**
+     * @brief Open an existing file read-only
+     *
+     * The mapping is PROT_READ, so only const access is allowed.
+     *
+     * @param path File to map
+     */
+    explicit MappedStackVector(const char* path) noexcept
+        : m_mapping(nullptr), m_mapping_size(0), m_read_only(true) {
+        open(path, 0, true);
+    }
+
+    MappedStackVector(const MappedStackVector&) = delete;
+    MappedStackVector& operator=(const MappedStackVector&) = delete;
+
+    /** @brief Move constructor; other is left invalid */
+    MappedStackVector(MappedStackVector&& other) noexcept
+        : m_mapping(other.m_mapping),
+          m_mapping_size(other.m_mapping_size),
+          m_read_only(other.m_read_only) {
+        other.m_mapping = nullptr;
+        other.m_mapping_size = 0;
+    }
+
+    /** @brief Move assignment; unmaps this file and leaves other invalid */
+    MappedStackVector& operator=(MappedStackVector&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_mapping = other.m_mapping;
+            m_mapping_size = other.m_mapping_size;
+            m_read_only = other.m_read_only;
+            other.m_mapping = nullptr;
+            other.m_mapping_size = 0;
+        }
+        return *this;
+    }
+
+    /// Unmaps the file; the kernel writes dirty pages back on its own schedule
+    ~MappedStackVector() { unmap(); }
+
+    /** @brief Check whether the file was opened and its fingerprint matched */
+    bool valid() const noexcept { return m_mapping != nullptr; }
+    /** @brief Check whether the vector was opened read-only */
+    bool read_only() const noexcept { return m_read_only; }
+
+    /**
+     * @brief Write dirty pages back to the file and wait for completion (msync)
+     *
+     * @return True on success; false if the vector is invalid or msync failed
+     */
+    bool flush() noexcept {
+#ifdef STACK_VEC_HAS_MMAP
+        return m_mapping != nullptr && msync(m_mapping, m_mapping_size, MS_SYNC) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /** @brief Add element to the end */
+    void push_back(const T& value) noexcept { emplace_back(value); }
+
+    /** @brief Construct element in place at the end */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value) {
+        assert(writable() && "MappedStackVector: modifying a read-only or invalid vector");
+        assert(size() < capacity() && "MappedStackVector: capacity exceeded");
+        T* slot = ::new (static_cast<void*>(data() + size())) T(std::forward<Args>(args)...);
+        ++header()->size;
+        return *slot;
+    }
+
+    /** @brief Remove the last element (must not be empty) */
+    void pop_back() noexcept {
+        assert(writable() && "MappedStackVector: modifying a read-only or invalid vector");
+        assert(!empty() && "MappedStackVector: pop_back on empty vector");
+        --header()->size;
+    }
+
+    /**
+     * @brief Append count elements with a single memcpy
+     *
+     * @param src Pointer to the elements to copy
+     * @param count Number of elements to copy
+     */
+    void insert_range(const T* src, std::size_t count) noexcept {
+        assert(writable() && "MappedStackVector: modifying a read-only or invalid vector");
+        assert(count <= capacity() - size() && "MappedStackVector: capacity exceeded");
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(data() + size()), src, count * sizeof(T));
+            header()->size += count;
+        }
+    }
+
+    /** @brief Append the elements of a BufferView<T> or BufferView<const T> with one memcpy */
+    template <typename U,
+              typename = std::enable_if_t<std::is_same<std::remove_const_t<U>, T>::value>>
+    void insert_range(BufferView<U> view) noexcept {
+        insert_range(static_cast<const T*>(view.m_data), view.m_size);
+    }
+
+    /**
+     * @brief Extend the size by count elements without initializing them
+     *
+     * The returned view covers the new elements so a producer can fill them in place.
+     */
+    BufferView<T> append_uninitialized(std::size_t count) noexcept {
+        assert(writable() && "MappedStackVector: modifying a read-only or invalid vector");
+        assert(count <= capacity() - size() && "MappedStackVector: capacity exceeded");
+        T* tail = data() + size();
+        header()->size += count;
+        return BufferView<T>{tail, count};
+    }
+
+    /** @brief Set the size to n, keeping the first n elements (n must not exceed size()) */
+    void truncate(std::size_t n) noexcept {
+        assert(writable() && "MappedStackVector: modifying a read-only or invalid vector");
+        assert(n <= size() && "MappedStackVector: truncate beyond size");
+        header()->size = n;
+    }
+
+    /** @brief Remove all elements */
+    void clear() noexcept {
+        if (writable()) {
+            header()->size = 0;
+        }
+    }
+
+    /** @brief Access element at index (unchecked) */
+    T& operator[](std::size_t idx) noexcept { return data()[idx]; }
+    /** @brief Access element at index (unchecked, const) */
+    const T& operator[](std::size_t idx) const noexcept { return data()[idx]; }
+
+    /** @brief Access the first element (must not be empty) */
+    T& front() noexcept { return data()[0]; }
+    /** @brief Access the first element (must not be empty, const) */
+    const T& front() const noexcept { return data()[0]; }
+    /** @brief Access the last element (must not be empty) */
+    T& back() noexcept { return data()[size() - 1]; }
+    /** @brief Access the last element (must not be empty, const) */
+    const T& back() const noexcept { return data()[size() - 1]; }
+
+    /** @brief Get iterator to beginning */
+    iterator begin() noexcept { return data(); }
+    /** @brief Get iterator to end */
+    iterator end() noexcept { return data() + size(); }
+    /** @brief Get const iterator to beginning */
+    const_iterator begin() const noexcept { return data(); }
+    /** @brief Get const iterator to end */
+    const_iterator end() const noexcept { return data() + size(); }
+
+    /** @brief Get number of elements */
+    std::size_t size() const noexcept {
+        return m_mapping != nullptr ? static_cast<std::size_t>(header()->size) : 0;
+    }
+    /** @brief Get the number of element slots in the file */
+    std::size_t capacity() const noexcept {
+        return m_mapping != nullptr ? static_cast<std::size_t>(header()->capacity) : 0;
+    }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return size() == 0; }
+    /** @brief Check if size has reached capacity */
+    bool full() const noexcept { return size() == capacity(); }
+
+    /** @brief Get pointer to the first element (nullptr if invalid) */
+    T* data() noexcept {
+        return m_mapping != nullptr ? reinterpret_cast<T*>(base() + data_offset) : nullptr;
+    }
+    /** @brief Get const pointer to the first element (nullptr if invalid) */
+    const T* data() const noexcept {
+        return m_mapping != nullptr ? reinterpret_cast<const T*>(base() + data_offset) : nullptr;
+    }
+
+    /** @brief Get the file size needed for capacity elements */
+    static constexpr std::size_t file_size(std::size_t capacity) noexcept {
+        return data_offset + capacity * sizeof(T);
+    }
+
+   private:
+    static constexpr std::size_t data_offset = mapped_internal::data_offset<T>();
+
+    unsigned char* base() const noexcept { return static_cast<unsigned char*>(m_mapping); }
+    mapped_internal::Header* header() const noexcept {
+        return static_cast<mapped_internal::Header*>(m_mapping);
+    }
+    bool writable() const noexcept { return m_mapping != nullptr && !m_read_only; }
+
+    /// Header fields that identify T, compared field by field on open
+    static mapped_internal::Header fingerprint() noexcept {
+        mapped_internal::Header h{};
+        h.magic = mapped_internal::magic;
+        h.layout_version = mapped_internal::layout_version;
+        h.user_version = Version;
+        h.type_hash = type_signature_internal::type_hash<T>();
+        h.element_size = static_cast<std::uint32_t>(sizeof(T));
+        h.element_align = static_cast<std::uint32_t>(alignof(T));
+        return h;
+    }
+
+    /**
+     * @brief Map path, initializing a new or empty file and checking an existing one
+     *
+     * Leaves m_mapping null on any failure. A file with a foreign header is never
+     * modified.
+     */
+    void open(const char* path, std::size_t capacity, bool read_only) noexcept {
+#ifdef STACK_VEC_HAS_MMAP
+        const int fd = ::open(path, read_only ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return;
+        }
+        std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        const bool fresh = bytes == 0;
+        if (fresh) {
+            bytes = file_size(capacity);
+            if (read_only || ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+                ::close(fd);
+                return;
+            }
+        } else if (bytes < data_offset) {
+            ::close(fd);
+            return;
+        }
+
+        const int prot = read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+        void* p = mmap(nullptr, bytes, prot, MAP_SHARED, fd, 0);
+        ::close(fd);  // the mapping keeps the file referenced
+        if (p == MAP_FAILED) {
+            return;
+        }
+        m_mapping = p;
+        m_mapping_size = bytes;
+
+        const mapped_internal::Header expected = fingerprint();
+        mapped_internal::Header* h = header();
+        if (fresh) {
+            *h = expected;
+            h->capacity = capacity;
+            h->size = 0;
+            return;
+        }
+        const bool matches =
+            h->magic == expected.magic && h->layout_version == expected.layout_version &&
+            h->user_version == expected.user_version && h->type_hash == expected.type_hash &&
+            h->element_size == expected.element_size &&
+            h->element_align == expected.element_align && h->size <= h->capacity &&
+            h->capacity <= (bytes - data_offset) / sizeof(T);
+        if (!matches) {
+            unmap();
+        }
+#else
+        (void)path;
+        (void)capacity;
+        (void)read_only;
+#endif
+    }
+
+    void unmap() noexcept {
+#ifdef STACK_VEC_HAS_MMAP
+        if (m_mapping != nullptr) {
+            munmap(m_mapping, m_mapping_size);
+        }
+#endif
+        m_mapping = nullptr;
+        m_mapping_size = 0;
+    }
+
+    /// Start of the file mapping (the header), or nullptr if invalid
+    void* m_mapping;
+    /// Length of the mapping in bytes
+    std::size_t m_mapping_size;
+    /// Whether the mapping is PROT_READ only
+    bool m_read_only;
+};
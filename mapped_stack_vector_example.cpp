@@ -0,0 +1,53 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+#include "mapped_stack_vector.hpp"
+
+struct Route {
+    std::uint32_t prefix;
+    std::uint8_t length;
+    std::uint16_t next_hop;
+};
+
+int main() {
+    const char* path = "routes.bin";
+    std::remove(path);
+
+    // Example 1: First run builds the table straight into the file
+    std::cout << "Example 1: Build a table into a mapped file\n";
+    {
+        MappedStackVector<Route> routes{path, 100000};
+        if (!routes.valid()) {
+            std::cout << "could not map " << path << "\n";
+            return 1;
+        }
+        for (std::uint32_t i = 0; i < 100000; ++i) {
+            routes.push_back(Route{i << 8, 24, static_cast<std::uint16_t>(i % 64)});
+        }
+        routes.flush();
+        std::cout << routes.size() << " routes, file size "
+                  << MappedStackVector<Route>::file_size(routes.capacity()) << " bytes\n\n";
+    }
+
+    // Example 2: Later runs get the data back without parsing
+    std::cout << "Example 2: Reopen read-only\n";
+    const auto start = std::chrono::steady_clock::now();
+    const MappedStackVector<Route> loaded{path};
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << loaded.size() << " routes in " << elapsed.count()
+              << " us, route 4242 -> hop " << loaded[4242].next_hop << "\n\n";
+
+    // Example 3: The fingerprint rejects a file holding another type
+    std::cout << "Example 3: Type mismatch\n";
+    MappedStackVector<std::uint64_t> wrong{path};
+    std::cout << "Opened as uint64_t: " << (wrong.valid() ? "valid" : "rejected") << "\n";
+    MappedStackVector<Route, 2> newer{path};
+    std::cout << "Opened as schema version 2: " << (newer.valid() ? "valid" : "rejected")
+              << "\n";
+
+    std::remove(path);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mmap_support.hpp"
+#include "stack_allocator.hpp"
+#include "stack_arena.hpp"
+
+/**
+ * @brief How MmapArena maps its region
+ *
+ * Every option is best effort: a request the system cannot honor is dropped and the
+ * corresponding MmapArena query reports what was actually obtained.
+ */
+struct MmapOptions {
+    /// Back the region with explicit huge pages (MAP_HUGETLB, Linux); falls back to
+    /// normal pages if the huge page pool cannot supply the region
+    bool huge_tlb = false;
+    /// Ask for transparent huge pages (madvise(MADV_HUGEPAGE), Linux)
+    bool transparent_huge_pages = true;
+    /// Fault every page in up front, after the huge page advice (MADV_POPULATE_WRITE, or
+    /// touching each page where that is unavailable)
+    bool populate = false;
+    /// Pin the region in RAM (mlock) so warmed pages are never swapped out
+    bool lock = false;
+    /// Huge page size, a power of two (otherwise both huge page options are ignored); the
+    /// region is rounded up to it, MAP_HUGETLB draws from the pool of that size and, for
+    /// transparent huge pages, the region is mapped at a multiple of it
+    std::size_t huge_page_size = std::size_t{2} << 20;
+};
+
+namespace mmap_internal {
+
+/**
+ * @brief Owner of one anonymous private mapping
+ *
+ * A separate base so the mapping exists before the ArenaResource base of MmapArena is
+ * constructed over it.
+ */
+class Region {
+   protected:
+    Region(std::size_t bytes, const MmapOptions& options) noexcept
+        : m_mapping(nullptr), m_mapping_size(0), m_huge_tlb(false), m_locked(false) {
+#ifdef STACK_VEC_HAS_MMAP
+        if (bytes == 0) {
+            return;
+        }
+        const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        // 1. Map without prefaulting, so the huge page advice below is in place before
+        //    the first fault
+#ifdef MAP_HUGETLB
+        if (options.huge_tlb && valid_huge_page_size(options, page)) {
+            map(stack_alloc_internal::align_up(bytes, options.huge_page_size),
+                flags | MAP_HUGETLB | huge_page_size_flag(options.huge_page_size));
+            m_huge_tlb = m_mapping != nullptr;
+        }
+#endif
+        if (m_mapping == nullptr) {
+            const bool thp = wants_thp(options, page);
+            const std::size_t size =
+                stack_alloc_internal::align_up(bytes, thp ? options.huge_page_size : page);
+            if (thp) {
+                map_aligned(size, flags, options.huge_page_size, page);
+            } else {
+                map(size, flags);
+            }
+        }
+        if (m_mapping == nullptr) {
+            return;
+        }
+        // 2. Advise transparent huge pages on the (huge page aligned) region
+#ifdef MADV_HUGEPAGE
+        if (wants_thp(options, page)) {
+            madvise(m_mapping, m_mapping_size, MADV_HUGEPAGE);
+        }
+#endif
+        // 3. Prefault, now that faults can be served with huge pages
+        if (options.populate) {
+            populate(page);
+        }
+        if (options.lock) {
+            m_locked = mlock(m_mapping, m_mapping_size) == 0;
+        }
+#else
+        (void)bytes;
+        (void)options;
+#endif
+    }
+
+    ~Region() {
+#ifdef STACK_VEC_HAS_MMAP
+        if (m_mapping != nullptr) {
+            munmap(m_mapping, m_mapping_size);
+        }
+#endif
+    }
+
+    Region(const Region&) = delete;
+    Region& operator=(const Region&) = delete;
+
+#ifdef STACK_VEC_HAS_MMAP
+    /// Whether huge_page_size is a power of two larger than a normal page
+    static bool valid_huge_page_size(const MmapOptions& options, std::size_t page) noexcept {
+        return options.huge_page_size > page &&
+               (options.huge_page_size & (options.huge_page_size - 1)) == 0;
+    }
+
+    /// MAP_HUGETLB size selector for huge_page_size, so e.g. 1 GiB pages come from the
+    /// 1 GiB pool rather than the default one (0 where the kernel headers lack it)
+    static int huge_page_size_flag(std::size_t huge_page_size) noexcept {
+#ifdef MAP_HUGE_SHIFT
+        int log2 = 0;
+        while ((std::size_t{1} << log2) < huge_page_size) {
+            ++log2;
+        }
+        return log2 << MAP_HUGE_SHIFT;
+#else
+        (void)huge_page_size;
+        return 0;
+#endif
+    }
+
+    /// Whether the region should be advised for transparent huge pages
+    bool wants_thp(const MmapOptions& options, std::size_t page) const noexcept {
+#ifdef MADV_HUGEPAGE
+        return options.transparent_huge_pages && !m_huge_tlb &&
+               valid_huge_page_size(options, page);
+#else
+        (void)options;
+        (void)page;
+        return false;
+#endif
+    }
+
+    void map(std::size_t size, int flags) noexcept {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p != MAP_FAILED) {
+            m_mapping = p;
+            m_mapping_size = size;
+        }
+    }
+
+    /// Map size bytes starting at an align boundary by over-mapping and trimming the ends
+    void map_aligned(std::size_t size, int flags, std::size_t align, std::size_t page) noexcept {
+        const std::size_t span = size + align - page;
+        void* p = mmap(nullptr, span, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p == MAP_FAILED) {
+            return;
+        }
+        char* raw = static_cast<char*>(p);
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw);
+        char* start = raw + (stack_alloc_internal::align_up(base, align) - base);
+        const std::size_t head = static_cast<std::size_t>(start - raw);
+        if (head != 0) {
+            munmap(raw, head);
+        }
+        if (span - head > size) {
+            munmap(start + size, span - head - size);
+        }
+        m_mapping = start;
+        m_mapping_size = size;
+    }
+
+    /// Fault every page in, with MADV_POPULATE_WRITE where the kernel supports it
+    void populate(std::size_t page) noexcept {
+#ifdef MADV_POPULATE_WRITE
+        if (madvise(m_mapping, m_mapping_size, MADV_POPULATE_WRITE) == 0) {
+            return;
+        }
+#endif
+        for (std::size_t offset = 0; offset < m_mapping_size; offset += page) {
+            static_cast<volatile unsigned char*>(m_mapping)[offset] = 0;
+        }
+    }
+#endif
+
+    /// Start of the mapping, or nullptr if mapping failed
+    void* m_mapping;
+    /// Length of the mapping in bytes (rounded up to whole pages)
+    std::size_t m_mapping_size;
+    /// Whether the mapping uses explicit huge pages
+    bool m_huge_tlb;
+    /// Whether mlock succeeded
+    bool m_locked;
+};
+
+}  // namespace mmap_internal
+
+/**
+ * @brief Bump arena whose buffer is a dedicated anonymous memory mapping
+ *
+ * Same interface as StackArena (it is an ArenaResource, so ArenaAllocator, RewindScope
+ * and the other arena users work unchanged), but the buffer comes from mmap instead of
+ * the object itself. Large working sets therefore stay off the thread stack, and the
+ * region can be backed by huge pages, prefaulted and locked so that, once warmed, it
+ * costs no page faults and few TLB entries.
+ *
+ * Example usage:
+ * @code
+ * MmapOptions options;
+ * options.huge_tlb = true;    // 2 MiB pages if the pool has them
+ * options.populate = true;    // no page faults on first touch
+ * MmapArena scratch{std::size_t{256} << 20, options};
+ * if (!scratch.valid()) {
+ *     // mmap failed; fall back or report
+ * }
+ * std::vector<float, ArenaAllocator<float>> samples{ArenaAllocator<float>{scratch}};
+ * @endcode
+ *
+ * @note Failure to map is reported through valid() (the arena then has capacity 0);
+ *       nothing throws
+ * @note Requires POSIX mmap; on other platforms valid() is always false
+ * @note The size is rounded up to whole pages (whole huge pages when huge pages are
+ *       used), so capacity() may exceed the requested size
+ */
+class MmapArena : private mmap_internal::Region, public ArenaResource {
+   public:
+    /**
+     * @brief Map a region of at least bytes bytes
+     *
+     * @param bytes Requested size in bytes
+     * @param options Paging options (default: normal pages with a transparent huge
+     *                page hint, faulted in lazily, not locked)
+     */
+    explicit MmapArena(std::size_t bytes, const MmapOptions& options = MmapOptions{}) noexcept
+        : Region(bytes, options), ArenaResource(m_mapping, m_mapping_size) {}
+
+    /** @brief Check whether the region was mapped */
+    bool valid() const noexcept { return m_mapping != nullptr; }
+    /** @brief Check whether the region is backed by explicit huge pages */
+    bool huge_pages() const noexcept { return m_huge_tlb; }
+    /** @brief Check whether the region is locked in RAM */
+    bool locked() const noexcept { return m_locked; }
+    /** @brief Get the start of the mapping */
+    void* data() const noexcept { return m_mapping; }
+};
@@ -0,0 +1,37 @@
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "mmap_arena.hpp"
+
+int main() {
+    // Example 1: A large scratch region that would not fit on the thread stack
+    std::cout << "Example 1: 64 MiB mmap-backed arena\n";
+    MmapOptions options;
+    options.huge_tlb = true;  // explicit huge pages if the pool has them, else normal pages
+    options.populate = true;  // prefault now instead of on first touch
+    MmapArena scratch{std::size_t{64} << 20, options};
+    if (!scratch.valid()) {
+        std::cout << "mmap failed\n";
+        return 1;
+    }
+    std::cout << "capacity " << (scratch.capacity() >> 20) << " MiB, huge pages "
+              << (scratch.huge_pages() ? "yes" : "no (THP hint only)") << ", locked "
+              << (scratch.locked() ? "yes" : "no") << "\n\n";
+
+    // Example 2: Same interface as StackArena
+    std::cout << "Example 2: Containers on the mapped region\n";
+    {
+        RewindScope scope{scratch};
+        std::vector<double, ArenaAllocator<double>> samples{ArenaAllocator<double>{scratch}};
+        samples.reserve(1000000);
+        for (int i = 0; i < 1000000; ++i) {
+            samples.push_back(i * 0.5);
+        }
+        std::cout << samples.size() << " samples, arena used " << (scratch.used() >> 20)
+                  << " MiB\n";
+    }
+    std::cout << "After scope: arena used " << scratch.used() << " bytes\n";
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * @brief Memory mapping availability
+ *
+ * Defines STACK_VEC_HAS_MMAP where mmap() and friends exist (POSIX systems). Code
+ * using them keeps a fallback for other platforms under `#ifdef STACK_VEC_HAS_MMAP`.
+ */
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STACK_VEC_HAS_MMAP 1
+#endif
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "stack_allocator.hpp"
+
+/**
+ * @brief Bounded multi-producer/multi-consumer queue with an inline slot array
+ *
+ * Each slot carries a sequence number that says whether it is ready for the producer
+ * or the consumer of a given lap (D. Vyukov's bounded queue). Producers and consumers
+ * claim positions with a CAS on their own cache-line-separated counter, so try_push and
+ * try_pop are lock-free and never allocate. The blocking push/pop spin on the lock-free
+ * path first and only then park on a condition variable; the mutex is touched by a
+ * successful operation only when a thread is actually parked.
+ *
+ * @tparam T The type of elements in the queue
+ * @tparam N The number of slots (must be a power of two, at least 2)
+ *
+ * Example usage:
+ * @code
+ * MpmcQueue<Job, 256> jobs;
+ *
+ * // any number of submitting threads
+ * jobs.push(Job{...});               // blocks while full
+ *
+ * // any number of worker threads
+ * Job job = jobs.pop();              // blocks while empty
+ * @endcode
+ *
+ * @note Not copyable or movable
+ */
+template <typename T, std::size_t N>
+class MpmcQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0,
+                  "MpmcQueue capacity must be a power of two and at least 2");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Assumed cache line size used to keep hot counters apart
+    static constexpr size_type cache_line = 64;
+    /// Failed attempts a blocking call makes before parking
+    static constexpr int spin_limit = 128;
+
+    /** @brief Construct an empty queue */
+    MpmcQueue() noexcept : m_enqueue(0), m_dequeue(0), m_waiting_push(0), m_waiting_pop(0) {
+        for (size_type i = 0; i < N; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /// Destroys any elements still queued
+    ~MpmcQueue() {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            const size_type end = m_enqueue.load(std::memory_order_relaxed);
+            for (size_type pos = m_dequeue.load(std::memory_order_relaxed); pos != end; ++pos) {
+                reinterpret_cast<T*>(m_slots[pos & mask].storage)->~T();
+            }
+        }
+    }
+
+    /**
+     * @brief Construct an element at the back without blocking
+     * @return true if enqueued, false if the queue is full
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        if (!emplace_impl(std::forward<Args>(args)...)) {
+            return false;
+        }
+        wake(m_waiting_pop, m_not_empty);
+        return true;
+    }
+
+    /** @brief Enqueue a copy of value without blocking */
+    bool try_push(const T& value) { return try_emplace(value); }
+    /** @brief Enqueue value by move without blocking */
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    /**
+     * @brief Move the front element into out without blocking
+     * @return true if an element was dequeued, false if the queue is empty
+     */
+    bool try_pop(T& out) {
+        if (!pop_impl(out)) {
+            return false;
+        }
+        wake(m_waiting_push, m_not_full);
+        return true;
+    }
+
+    /**
+     * @brief Enqueue a copy of value, waiting while the queue is full
+     */
+    void push(const T& value) {
+        wait_until(m_waiting_push, m_not_full, [&] { return emplace_impl(value); });
+        wake(m_waiting_pop, m_not_empty);
+    }
+
+    /**
+     * @brief Enqueue value by move, waiting while the queue is full
+     */
+    void push(T&& value) {
+        wait_until(m_waiting_push, m_not_full, [&] { return emplace_impl(std::move(value)); });
+        wake(m_waiting_pop, m_not_empty);
+    }
+
+    /**
+     * @brief Move the front element into out, waiting while the queue is empty
+     */
+    void pop(T& out) {
+        wait_until(m_waiting_pop, m_not_empty, [&] { return pop_impl(out); });
+        wake(m_waiting_push, m_not_full);
+    }
+
+    /**
+     * @brief Remove and return the front element, waiting while the queue is empty
+     * @note Requires T to be default constructible
+     */
+    T pop() {
+        T out;
+        pop(out);
+        return out;
+    }
+
+    /** @brief Get an approximate element count */
+    std::size_t size_approx() const noexcept {
+        const size_type dequeued = m_dequeue.load(std::memory_order_acquire);
+        const size_type enqueued = m_enqueue.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+    /** @brief Check whether the queue looks empty */
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+
+   private:
+    static constexpr size_type mask = N - 1;
+
+    /// One element plus the sequence number that hands it between producers and consumers
+    struct Slot {
+        std::atomic<size_type> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /// Claim the tail slot and construct into it; false if full
+    template <typename... Args>
+    bool emplace_impl(Args&&... args) {
+        size_type pos = m_enqueue.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos & mask];
+            const size_type seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Claim the head slot and move out of it; false if empty
+    bool pop_impl(T& out) {
+        size_type pos = m_dequeue.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos & mask];
+            const size_type seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeue.load(std::memory_order_relaxed);
+            }
+        }
+        T* elem = reinterpret_cast<T*>(slot->storage);
+        out = std::move(*elem);
+        stack_alloc_internal::destroy_n(elem, 1);
+        slot->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Retry attempt until it succeeds, spinning first and then parking on cv
+     *
+     * The caller wakes the other side afterwards, once the mutex has been released.
+     * The waiter count is raised before the final re-check, and wake() reads it after
+     * the successful operation, with a full fence on both sides. Either the re-check
+     * sees the operation or the waker sees the waiter and notifies under the mutex the
+     * waiter still holds, so a wake-up cannot be lost.
+     */
+    template <typename Attempt>
+    void wait_until(std::atomic<unsigned>& waiters, std::condition_variable& cv,
+                    Attempt attempt) {
+        for (int i = 0; i < spin_limit; ++i) {
+            if (attempt()) {
+                return;
+            }
+            if (i >= spin_limit / 2) {
+                std::this_thread::yield();
+            }
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!attempt()) {
+            cv.wait(lock);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// Notify parked threads of the other side, if there are any
+    void wake(std::atomic<unsigned>& waiters, std::condition_variable& cv) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            cv.notify_all();
+        }
+    }
+
+    /// Inline slot array
+    alignas(cache_line) Slot m_slots[N];
+    /// Next position producers claim
+    alignas(cache_line) std::atomic<size_type> m_enqueue;
+    /// Next position consumers claim
+    alignas(cache_line) std::atomic<size_type> m_dequeue;
+    /// Producers parked in push()
+    alignas(cache_line) std::atomic<unsigned> m_waiting_push;
+    /// Consumers parked in pop()
+    std::atomic<unsigned> m_waiting_pop;
+    /// Guards parking only; never taken on the lock-free path
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+};
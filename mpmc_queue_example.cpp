@@ -0,0 +1,73 @@
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mpmc_queue.hpp"
+#include "parallel_runner.hpp"
+
+struct CheckJob {
+    int id;
+    int value;
+};
+
+int main() {
+    // Example 1: Non-blocking use
+    std::cout << "Example 1: try_push/try_pop\n";
+    MpmcQueue<std::string, 2> names;
+    std::cout << "push a: " << names.try_push("a") << ", push b: " << names.try_push("b")
+              << ", push c (full): " << names.try_push("c") << "\n";
+    std::string name;
+    while (names.try_pop(name)) {
+        std::cout << "popped " << name << "\n";
+    }
+    std::cout << "\n";
+
+    // Example 2: Many submitters feeding a pool of checker threads
+    std::cout << "Example 2: Work queue feeding ParallelRunner checks\n";
+    constexpr int submitters = 4;
+    constexpr int jobs_each = 5000;
+    constexpr int workers = 3;
+    static MpmcQueue<CheckJob, 64> jobs;
+    std::atomic<int> passed{0};
+    std::atomic<int> failed{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workers; ++w) {
+        threads.emplace_back([&] {
+            for (;;) {
+                CheckJob job = jobs.pop();
+                if (job.id < 0) {
+                    return;
+                }
+                auto checks = make_parallel_runner(
+                    [&] { return job.value >= 0; }, "value must be non-negative",
+                    [&] { return job.value % 7 != 0; }, "value must not be a multiple of 7");
+                checks.run();
+                (checks.all_succeeded() ? passed : failed)
+                    .fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (int s = 0; s < submitters; ++s) {
+        threads.emplace_back([s] {
+            for (int i = 0; i < jobs_each; ++i) {
+                jobs.push(CheckJob{s * jobs_each + i, i});
+            }
+        });
+    }
+    for (int s = 0; s < submitters; ++s) {
+        threads[workers + s].join();
+    }
+    for (int w = 0; w < workers; ++w) {
+        jobs.push(CheckJob{-1, 0});  // one stop marker per worker
+    }
+    for (int w = 0; w < workers; ++w) {
+        threads[w].join();
+    }
+    std::cout << "Checked " << passed + failed << " jobs: " << passed << " passed, " << failed
+              << " failed\n";
+
+    return 0;
+}
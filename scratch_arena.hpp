@@ -0,0 +1,304 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+
+#include "stack_arena.hpp"
+
+/// Size in bytes of each thread's scratch arena returned by scratch_arena()
+#ifndef STACK_VEC_SCRATCH_ARENA_SIZE
+#define STACK_VEC_SCRATCH_ARENA_SIZE (64 * 1024)
+#endif
+
+/**
+ * @brief Per-thread bump arena that accepts frees from other threads
+ *
+ * Allocation and same-thread deallocation touch only the owning thread's state, so
+ * short-lived task buffers never contend on a lock. A block freed on a different thread
+ * is pushed onto the owner's lock-free return list and handed back to the arena the next
+ * time the owner allocates or resets. When the last outstanding block comes back, the
+ * region is rewound automatically (down to the start of the innermost open
+ * ScratchScope).
+ *
+ * Each block carries a small header in front of it so it can be returned without
+ * knowing its position in the buffer.
+ *
+ * @note This class does not throw exceptions; allocation failures return nullptr
+ * @note Blocks handed to other threads must be freed before the owner's next reset()
+ *       and before the owning thread exits
+ * @note Not copyable or movable: allocator handles refer to the arena by address
+ */
+class ScratchArena {
+   public:
+    using size_type = std::size_t;
+
+    /// Default alignment for allocations that do not specify one
+    static constexpr size_type default_alignment = ArenaResource::default_alignment;
+
+    /**
+     * @brief Construct a scratch arena over an existing buffer, owned by the calling thread
+     *
+     * @param buffer Start of the buffer to allocate from
+     * @param size Size of the buffer in bytes
+     */
+    ScratchArena(void* buffer, size_type size) noexcept
+        : m_arena(buffer, size),
+          m_owner(std::this_thread::get_id()),
+          m_live(0),
+          m_root{nullptr, 0, 0},
+          m_top(&m_root),
+          m_returned(nullptr) {}
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * @brief Allocate bytes with the given alignment (owning thread only)
+     *
+     * Blocks returned by other threads are reclaimed first.
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the returned pointer, must be a power of two
+     * @return Pointer to the allocated memory, or nullptr if the arena is exhausted
+     */
+    void* allocate(size_type bytes, size_type align = default_alignment) noexcept {
+        assert(on_owner_thread() && "ScratchArena: allocate from a non-owning thread");
+        reclaim_returned();
+
+        const size_type block_align = align > alignof(BlockHeader) ? align : alignof(BlockHeader);
+        const size_type header_space =
+            stack_alloc_internal::align_up(sizeof(BlockHeader), block_align);
+        const size_type mark = m_arena.mark();
+        char* raw = static_cast<char*>(m_arena.allocate(header_space + bytes, block_align));
+        if (raw == nullptr) {
+            return nullptr;
+        }
+
+        char* user = raw + header_space;
+        BlockHeader* header = header_of(user);
+        header->next = nullptr;
+        header->raw = raw;
+        header->total = header_space + bytes;
+        header->mark = mark;
+        ++m_live;
+        ++m_top->live;
+        return user;
+    }
+
+    /**
+     * @brief Return a block from any thread
+     *
+     * On the owning thread the block is released immediately. On any other thread it is
+     * pushed onto the owner's return list without touching the owner's bump state.
+     *
+     * @param p Pointer returned by allocate()
+     */
+    void deallocate(void* p, size_type = 0, size_type = default_alignment) noexcept {
+        BlockHeader* header = header_of(p);
+        if (on_owner_thread()) {
+            release(header);
+            return;
+        }
+        BlockHeader* head = m_returned.load(std::memory_order_relaxed);
+        do {
+            header->next = head;
+        } while (!m_returned.compare_exchange_weak(head, header, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Drop every allocation at once (owning thread only)
+     *
+     * Intended to be called between tasks, outside any ScratchScope; use a ScratchScope
+     * to release only what one task allocated.
+     */
+    void reset() noexcept {
+        assert(on_owner_thread() && "ScratchArena: reset from a non-owning thread");
+        assert(m_top == &m_root && "ScratchArena: reset inside an open ScratchScope");
+        m_returned.exchange(nullptr, std::memory_order_acquire);
+        m_live = 0;
+        m_root.live = 0;
+        m_arena.reset();
+    }
+
+    /** @brief Check whether the calling thread owns this arena */
+    bool on_owner_thread() const noexcept { return std::this_thread::get_id() == m_owner; }
+
+    /** @brief Get number of blocks not yet returned to the owner */
+    size_type live_blocks() const noexcept { return m_live; }
+    /** @brief Get number of bytes in use (including block headers and padding) */
+    size_type used() const noexcept { return m_arena.used(); }
+    /** @brief Get total size of the buffer in bytes */
+    size_type capacity() const noexcept { return m_arena.capacity(); }
+
+   private:
+    friend class ScratchScope;
+
+    /// Bookkeeping stored immediately before each block
+    struct BlockHeader {
+        BlockHeader* next;  ///< Link in the cross-thread return list
+        char* raw;          ///< Start of the underlying arena allocation
+        size_type total;    ///< Size of the underlying arena allocation
+        size_type mark;     ///< Arena offset when the block was allocated
+    };
+
+    /**
+     * @brief One open ScratchScope (or the arena itself, for the root frame)
+     *
+     * Frames form a stack through parent. A block belongs to the innermost frame whose
+     * floor is not above the arena offset at which the block was allocated.
+     */
+    struct Frame {
+        Frame* parent;    ///< Enclosing frame, nullptr for the root
+        size_type floor;  ///< Arena offset when the frame was opened
+        size_type live;   ///< Blocks allocated in this frame and not yet released
+    };
+
+    /// Open a nested frame at the current offset (owning thread only)
+    void enter(Frame& frame) noexcept {
+        assert(on_owner_thread() && "ScratchArena: scope opened on a non-owning thread");
+        reclaim_returned();
+        frame.parent = m_top;
+        frame.floor = m_arena.mark();
+        frame.live = 0;
+        m_top = &frame;
+    }
+
+    /// Close the innermost frame, dropping the blocks allocated in it
+    void leave(Frame& frame) noexcept {
+        assert(m_top == &frame && "ScratchArena: scopes closed out of order");
+        reclaim_returned();
+        m_live -= frame.live;
+        m_top = frame.parent;
+        m_arena.rewind(m_live == 0 ? m_top->floor : frame.floor);
+    }
+
+    static BlockHeader* header_of(void* user) noexcept {
+        return reinterpret_cast<BlockHeader*>(static_cast<char*>(user) - sizeof(BlockHeader));
+    }
+
+    /// Give a block back to the bump arena (owning thread only)
+    void release(BlockHeader* header) noexcept {
+        assert(m_live > 0 && "ScratchArena: more frees than allocations");
+        Frame* frame = m_top;
+        while (header->mark < frame->floor) {
+            frame = frame->parent;
+        }
+        assert(frame->live > 0 && "ScratchArena: block released after its scope closed");
+        --frame->live;
+        if (frame == m_top) {
+            // Blocks of enclosing frames lie below the floor and must not move the offset
+            m_arena.deallocate(header->raw, header->total);
+        }
+        if (--m_live == 0) {
+            m_arena.rewind(m_top->floor);
+        }
+    }
+
+    /// Release every block other threads have returned since the last call
+    void reclaim_returned() noexcept {
+        if (m_returned.load(std::memory_order_relaxed) == nullptr) {
+            return;
+        }
+        BlockHeader* header = m_returned.exchange(nullptr, std::memory_order_acquire);
+        while (header != nullptr) {
+            BlockHeader* next = header->next;
+            release(header);
+            header = next;
+        }
+    }
+
+    /// Underlying bump arena
+    ArenaResource m_arena;
+    /// Thread allowed to allocate and to release blocks directly
+    std::thread::id m_owner;
+    /// Blocks handed out and not yet released, across all frames
+    size_type m_live;
+    /// Frame for blocks allocated outside any ScratchScope
+    Frame m_root;
+    /// Innermost open frame
+    Frame* m_top;
+    /// Blocks freed by other threads, waiting for the owner
+    std::atomic<BlockHeader*> m_returned;
+};
+
+/**
+ * @brief Scratch arena that holds its own N-byte buffer inline
+ *
+ * @tparam N The size of the buffer in bytes
+ */
+template <std::size_t N>
+class StackScratchArena : public ScratchArena {
+   public:
+    /** @brief Construct an empty scratch arena owned by the calling thread */
+    StackScratchArena() noexcept : ScratchArena(m_buffer, N) {}
+
+   private:
+    /// Inline buffer, aligned for any fundamental type
+    alignas(std::max_align_t) unsigned char m_buffer[N];
+};
+
+/**
+ * @brief Get the calling thread's scratch arena
+ *
+ * The arena is created on first use in each thread and holds
+ * STACK_VEC_SCRATCH_ARENA_SIZE bytes of thread-local storage.
+ */
+inline ScratchArena& scratch_arena() noexcept {
+    thread_local StackScratchArena<STACK_VEC_SCRATCH_ARENA_SIZE> arena;
+    return arena;
+}
+
+/**
+ * @brief Allocator handle bound to a ScratchArena
+ *
+ * @tparam T The type of objects to allocate
+ */
+template <typename T>
+using ScratchAllocator = ArenaAllocator<T, ScratchArena>;
+
+/**
+ * @brief RAII per-task scope that releases what was allocated inside it on exit
+ *
+ * Scopes nest: a helper may open its own ScratchScope while the caller's blocks are
+ * still live, and closing it rewinds the arena only to where it was opened. Blocks
+ * allocated in a scope must be freed (on any thread) before the scope closes or not
+ * at all.
+ *
+ * Example usage:
+ * @code
+ * pool.submit([] {
+ *     ScratchScope scope;
+ *     std::vector<char, ScratchAllocator<char>> buf{scope.allocator<char>()};
+ *     // ... task work; buf must be destroyed before scope
+ * });
+ * @endcode
+ */
+class ScratchScope {
+   public:
+    /** @brief Bind to the calling thread's scratch arena and record its position */
+    ScratchScope() noexcept : m_arena(scratch_arena()) { m_arena.enter(m_frame); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    /** @brief Rewind the arena to where this scope was opened */
+    ~ScratchScope() { m_arena.leave(m_frame); }
+
+    /** @brief Get the arena this scope allocates from */
+    ScratchArena& arena() const noexcept { return m_arena; }
+
+    /** @brief Get an allocator handle for the arena */
+    template <typename T>
+    ScratchAllocator<T> allocator() const noexcept {
+        return ScratchAllocator<T>{m_arena};
+    }
+
+   private:
+    /// The calling thread's scratch arena
+    ScratchArena& m_arena;
+    /// Position and live-block count of this scope within the arena
+    ScratchArena::Frame m_frame;
+};
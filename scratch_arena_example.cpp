@@ -0,0 +1,71 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "scratch_arena.hpp"
+
+int main() {
+    // Example 1: Per-task scratch buffers from the thread-local arena
+    std::cout << "Example 1: Per-task scratch buffers\n";
+    for (int task = 0; task < 3; ++task) {
+        ScratchScope scope;
+        std::vector<int, ScratchAllocator<int>> buf{scope.allocator<int>()};
+        buf.reserve(100);
+        for (int i = 0; i < 100; ++i) {
+            buf.push_back(i * task);
+        }
+        std::cout << "task " << task << ": last = " << buf.back()
+                  << ", arena used = " << scope.arena().used() << " bytes\n";
+    }
+    std::cout << "Arena used after tasks: " << scratch_arena().used() << " bytes\n\n";
+
+    // Example 2: Worker threads each get their own arena
+    std::cout << "Example 2: Worker threads\n";
+    std::vector<std::thread> workers;
+    std::size_t used[4] = {};
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([w, &used] {
+            ScratchArena& arena = scratch_arena();
+            void* block = arena.allocate(256 * (w + 1));
+            used[w] = arena.used();
+            arena.deallocate(block);
+        });
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    for (int w = 0; w < 4; ++w) {
+        std::cout << "worker " << w << " used " << used[w] << " bytes\n";
+    }
+
+    // Example 3: A block freed on another thread is returned to its owner
+    std::cout << "\nExample 3: Cross-thread free\n";
+    ScratchArena& arena = scratch_arena();
+    void* block = arena.allocate(512);
+    std::cout << "Live blocks before: " << arena.live_blocks() << "\n";
+    std::thread consumer([&arena, block] { arena.deallocate(block); });
+    consumer.join();
+    void* next = arena.allocate(64);  // owner reclaims the returned block here
+    std::cout << "Live blocks after reclaim: " << arena.live_blocks() << "\n";
+    arena.deallocate(next);
+    std::cout << "Arena used: " << arena.used() << " bytes\n";
+
+    // Example 4: A helper opening its own scope leaves the caller's blocks alone
+    std::cout << "\nExample 4: Nested scopes\n";
+    {
+        ScratchScope task;
+        std::vector<int, ScratchAllocator<int>> results{task.allocator<int>()};
+        results.reserve(16);
+        {
+            ScratchScope helper;  // e.g. inside a parsing routine
+            std::vector<char, ScratchAllocator<char>> tmp{helper.allocator<char>()};
+            tmp.assign(200, 'x');
+            results.push_back(static_cast<int>(tmp.size()));
+        }  // rewinds to where the helper started, not to the start of the task
+        results.push_back(1);
+        std::cout << "Caller still holds " << results.size() << " results, "
+                  << scratch_arena().live_blocks() << " live block\n";
+    }
+
+    return 0;
+}
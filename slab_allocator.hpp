@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "stack_arena.hpp"
+
+/**
+ * @brief Fixed-buffer allocator with per-size-class free lists
+ *
+ * Requests up to MaxClassSize bytes are rounded up to a multiple of Granularity and
+ * served from the free list of that size class, falling back to bumping through the
+ * buffer when the list is empty. Freed blocks go back on their class's free list, so
+ * node containers that constantly insert and erase recycle nodes in O(1) without ever
+ * touching the heap. Larger requests are bump-allocated and only reclaimed in LIFO order.
+ *
+ * @tparam MaxClassSize Largest request size (in bytes) served by a size class
+ * @tparam Granularity Size class step and block alignment in bytes (power of two)
+ *
+ * Example usage:
+ * @code
+ * StackSlab<64 * 1024> slab;
+ * using Alloc = SlabAllocator<std::pair<const Price, Level>>;
+ * std::map<Price, Level, std::less<Price>, Alloc> book{Alloc{slab}};
+ * @endcode
+ *
+ * @note This class does not throw exceptions; allocation failures return nullptr
+ * @note Memory on a free list is only reused for its own size class
+ * @note Not copyable or movable: allocator handles refer to the slab by address
+ */
+template <std::size_t MaxClassSize = 256, std::size_t Granularity = alignof(std::max_align_t)>
+class SlabResource {
+    static_assert((Granularity & (Granularity - 1)) == 0, "Granularity must be a power of two");
+    static_assert(Granularity >= sizeof(void*), "Granularity must fit a free-list link");
+    static_assert(MaxClassSize % Granularity == 0,
+                  "MaxClassSize must be a multiple of Granularity");
+
+   public:
+    using size_type = std::size_t;
+
+    /// Number of size classes with their own free list
+    static constexpr size_type class_count = MaxClassSize / Granularity;
+
+    /**
+     * @brief Construct a slab over an existing buffer
+     *
+     * @param buffer Start of the buffer to allocate from
+     * @param size Size of the buffer in bytes
+     * @note The buffer must outlive the slab and every allocation made from it
+     */
+    SlabResource(void* buffer, size_type size) noexcept
+        : m_begin(static_cast<char*>(buffer)), m_size(size), m_offset(0), m_free{} {
+        // Start on a Granularity boundary so every bumped block is aligned
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_begin);
+        m_offset = stack_alloc_internal::align_up(base, Granularity) - base;
+        m_start = m_offset;
+    }
+
+    SlabResource(const SlabResource&) = delete;
+    SlabResource& operator=(const SlabResource&) = delete;
+
+    /**
+     * @brief Allocate bytes with the given alignment
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the returned pointer, must be a power of two
+     * @return Pointer to the allocated memory, or nullptr if the buffer is exhausted
+     *
+     * @note This function never throws. On failure, it asserts in debug builds and returns nullptr.
+     */
+    void* allocate(size_type bytes, size_type align = Granularity) noexcept {
+        if (bytes <= MaxClassSize && align <= Granularity) {
+            const size_type cls = class_index(bytes);
+            if (FreeNode* node = m_free[cls]) {
+                m_free[cls] = node->next;
+                return node;
+            }
+            return bump(class_size(cls), Granularity);
+        }
+        return bump(bytes, align > Granularity ? align : Granularity);
+    }
+
+    /**
+     * @brief Return memory to the slab
+     *
+     * Size-class blocks are pushed onto their free list in O(1). Larger blocks are only
+     * reclaimed if they are the most recent bump allocation.
+     *
+     * @param p Pointer returned by allocate()
+     * @param bytes Size passed to allocate()
+     * @param align Alignment passed to allocate()
+     */
+    void deallocate(void* p, size_type bytes, size_type align = Granularity) noexcept {
+        if (bytes <= MaxClassSize && align <= Granularity) {
+            const size_type cls = class_index(bytes);
+            FreeNode* node = static_cast<FreeNode*>(p);
+            node->next = m_free[cls];
+            m_free[cls] = node;
+            return;
+        }
+        char* ptr = static_cast<char*>(p);
+        if (ptr + stack_alloc_internal::align_up(bytes, Granularity) == m_begin + m_offset) {
+            m_offset = static_cast<size_type>(ptr - m_begin);
+        }
+    }
+
+    /**
+     * @brief Release every allocation and empty all free lists
+     *
+     * @warning Objects still living in the slab are not destroyed
+     */
+    void reset() noexcept {
+        m_offset = m_start;
+        for (size_type i = 0; i < class_count; ++i) {
+            m_free[i] = nullptr;
+        }
+    }
+
+    /** @brief Check whether p points into this slab's buffer */
+    bool owns(const void* p) const noexcept {
+        const char* ptr = static_cast<const char*>(p);
+        return ptr >= m_begin && ptr < m_begin + m_size;
+    }
+
+    /** @brief Get number of bytes carved from the buffer (including free-listed blocks) */
+    size_type used() const noexcept { return m_offset - m_start; }
+    /** @brief Get total size of the buffer in bytes */
+    size_type capacity() const noexcept { return m_size; }
+    /** @brief Get number of bytes never handed out */
+    size_type remaining() const noexcept { return m_size - m_offset; }
+
+    /** @brief Get number of blocks waiting on the free list for a request of bytes */
+    size_type free_blocks(size_type bytes) const noexcept {
+        size_type count = 0;
+        for (const FreeNode* node = m_free[class_index(bytes)]; node; node = node->next) {
+            ++count;
+        }
+        return count;
+    }
+
+   private:
+    /// Link stored inside each freed block
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    /// Size class for a request of bytes (0 bytes shares the smallest class)
+    static constexpr size_type class_index(size_type bytes) noexcept {
+        return bytes == 0 ? 0 : (bytes - 1) / Granularity;
+    }
+
+    /// Block size handed out for a size class
+    static constexpr size_type class_size(size_type cls) noexcept {
+        return (cls + 1) * Granularity;
+    }
+
+    /// Carve a new block from the untouched part of the buffer
+    void* bump(size_type bytes, size_type align) noexcept {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_begin);
+        const size_type start = stack_alloc_internal::align_up(base + m_offset, align) - base;
+        const size_type rounded = stack_alloc_internal::align_up(bytes, Granularity);
+
+        if (start > m_size || rounded > m_size - start) {
+            assert(false && "SlabResource: buffer overflow");
+            return nullptr;
+        }
+
+        m_offset = start + rounded;
+        return m_begin + start;
+    }
+
+    /// Start of the borrowed buffer
+    char* m_begin;
+    /// Size of the buffer in bytes
+    size_type m_size;
+    /// Current bump offset into the buffer
+    size_type m_offset;
+    /// First Granularity-aligned offset in the buffer
+    size_type m_start;
+    /// Head of the free list for each size class
+    FreeNode* m_free[class_count];
+};
+
+/**
+ * @brief Slab that holds its own N-byte buffer inline
+ *
+ * @tparam N The size of the buffer in bytes
+ * @tparam MaxClassSize Largest request size (in bytes) served by a size class
+ * @tparam Granularity Size class step and block alignment in bytes
+ */
+template <std::size_t N, std::size_t MaxClassSize = 256,
+          std::size_t Granularity = alignof(std::max_align_t)>
+class StackSlab : public SlabResource<MaxClassSize, Granularity> {
+   public:
+    /** @brief Construct an empty slab over the inline buffer */
+    StackSlab() noexcept : SlabResource<MaxClassSize, Granularity>(m_buffer, N) {}
+
+   private:
+    /// Inline buffer, aligned to the size class granularity
+    alignas(Granularity) unsigned char m_buffer[N];
+};
+
+/**
+ * @brief Allocator handle that recycles nodes through a SlabResource
+ *
+ * @tparam T The type of objects to allocate
+ * @tparam MaxClassSize Largest request size (in bytes) served by a size class
+ * @tparam Granularity Size class step and block alignment in bytes
+ */
+template <typename T, std::size_t MaxClassSize = 256,
+          std::size_t Granularity = alignof(std::max_align_t)>
+using SlabAllocator = ArenaAllocator<T, SlabResource<MaxClassSize, Granularity>>;
@@ -0,0 +1,42 @@
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+
+#include "slab_allocator.hpp"
+
+int main() {
+    // Example 1: A map that churns inserts and erases without running out of buffer
+    std::cout << "Example 1: Order book churn\n";
+    StackSlab<16 * 1024> slab;
+    {
+        using Alloc = SlabAllocator<std::pair<const int, int>>;
+        std::map<int, int, std::less<int>, Alloc> book{Alloc{slab}};
+
+        for (int round = 0; round < 10000; ++round) {
+            book[round % 100] += round;
+            if (book.size() > 50) {
+                book.erase(book.begin());
+            }
+        }
+        std::cout << "Levels: " << book.size() << ", slab used: " << slab.used() << " of "
+                  << slab.capacity() << " bytes\n";
+    }
+
+    // Example 2: Freed nodes are reused in O(1)
+    std::cout << "\nExample 2: Node recycling\n";
+    slab.reset();
+    std::list<int, SlabAllocator<int>> queue{SlabAllocator<int>{slab}};
+    for (int i = 0; i < 8; ++i) {
+        queue.push_back(i);
+    }
+    const auto used_before = slab.used();
+    for (int i = 0; i < 1000; ++i) {
+        queue.pop_front();
+        queue.push_back(i);
+    }
+    std::cout << "Used before churn: " << used_before << " bytes, after: " << slab.used()
+              << " bytes\n";
+
+    return 0;
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "buffer_view.hpp"
+#include "stack_allocator.hpp"
+
+/**
+ * @brief Wait-free single-producer/single-consumer queue with inline slots
+ *
+ * Slots live directly in the object, like StackVector elements. The producer owns the
+ * tail index and the consumer owns the head index; each sits on its own cache line
+ * next to a cached copy of the other side's index, so the shared indices are only
+ * re-read when the cached value says the queue looks full (producer) or empty
+ * (consumer). Every operation completes in a bounded number of steps.
+ *
+ * @tparam T The type of elements in the queue
+ * @tparam N The number of slots (must be a power of two)
+ *
+ * Example usage:
+ * @code
+ * SpscQueue<Packet, 1024> queue;
+ *
+ * // network thread
+ * while (!queue.try_push(packet)) { }
+ *
+ * // processing thread
+ * auto batch = queue.read_view();   // contiguous run of ready packets
+ * for (Packet& p : batch) { handle(p); }
+ * queue.commit_read(batch.m_size);
+ * @endcode
+ *
+ * @note Exactly one thread may call producer functions (try_push*, write_view,
+ *       commit_write) and exactly one thread may call consumer functions (try_pop*,
+ *       read_view, commit_read)
+ * @note Not copyable or movable
+ */
+template <typename T, std::size_t N>
+class SpscQueue {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Assumed cache line size used to keep producer and consumer state apart
+    static constexpr size_type cache_line = 64;
+
+    /** @brief Construct an empty queue */
+    SpscQueue() noexcept : m_tail(0), m_head_cache(0), m_head(0), m_tail_cache(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Destroys any elements still queued
+    ~SpscQueue() {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            const size_type tail = m_tail.load(std::memory_order_relaxed);
+            for (size_type i = m_head.load(std::memory_order_relaxed); i != tail; ++i) {
+                slot(i)->~T();
+            }
+        }
+    }
+
+    /**
+     * @brief Construct an element at the back (producer only)
+     * @return true if enqueued, false if the queue is full
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache == N) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == N) {
+                return false;
+            }
+        }
+        ::new (static_cast<void*>(slot(tail))) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Enqueue a copy of value (producer only) */
+    bool try_push(const T& value) { return try_emplace(value); }
+    /** @brief Enqueue value by move (producer only) */
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    /**
+     * @brief Move the front element into out (consumer only)
+     * @return true if an element was dequeued, false if the queue is empty
+     */
+    bool try_pop(T& out) {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail_cache) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache) {
+                return false;
+            }
+        }
+        T* elem = slot(head);
+        out = std::move(*elem);
+        stack_alloc_internal::destroy_n(elem, 1);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Enqueue up to count elements from src with one index publish (producer only)
+     *
+     * If a copy throws, the elements already copied are destroyed and nothing is enqueued.
+     *
+     * @return Number of elements enqueued
+     */
+    size_type try_push_n(const T* src, size_type count) {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        size_type space = N - (tail - m_head_cache);
+        if (space < count) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            space = N - (tail - m_head_cache);
+        }
+        const size_type n = count < space ? count : space;
+        size_type i = 0;
+        try {
+            for (; i < n; ++i) {
+                ::new (static_cast<void*>(slot(tail + i))) T(src[i]);
+            }
+        } catch (...) {
+            for (size_type j = 0; j < i; ++j) {
+                stack_alloc_internal::destroy_n(slot(tail + j), 1);
+            }
+            throw;
+        }
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Dequeue up to count elements into dst with one index publish (consumer only)
+     *
+     * dst must hold count constructed objects, which are move-assigned.
+     *
+     * @return Number of elements dequeued
+     */
+    size_type try_pop_n(T* dst, size_type count) {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        size_type ready = m_tail_cache - head;
+        if (ready < count) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            ready = m_tail_cache - head;
+        }
+        const size_type n = count < ready ? count : ready;
+        for (size_type i = 0; i < n; ++i) {
+            T* elem = slot(head + i);
+            dst[i] = std::move(*elem);
+            stack_alloc_internal::destroy_n(elem, 1);
+        }
+        m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Get the contiguous run of free slots behind the tail (producer only)
+     *
+     * Write elements into the view, then publish them with commit_write(). The view
+     * stops at the end of the buffer; call again after committing to get the rest.
+     *
+     * @note Only available when T is trivially copyable
+     */
+    template <typename U = T>
+    std::enable_if_t<std::is_trivially_copyable<U>::value, BufferView<T>> write_view() noexcept {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        m_head_cache = m_head.load(std::memory_order_acquire);
+        return BufferView<T>{slot(tail), contiguous_from(tail, N - (tail - m_head_cache))};
+    }
+
+    /**
+     * @brief Publish count elements written through write_view() (producer only)
+     * @note Only available when T is trivially copyable
+     */
+    template <typename U = T>
+    std::enable_if_t<std::is_trivially_copyable<U>::value> commit_write(size_type count) noexcept {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        assert(count <= N - (tail - m_head_cache) && "SpscQueue: commit past free space");
+        m_tail.store(tail + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the contiguous run of ready elements at the head (consumer only)
+     *
+     * Process the elements in place, then release them with commit_read(). The view
+     * stops at the end of the buffer; call again after committing to get the rest.
+     */
+    BufferView<T> read_view() noexcept {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        m_tail_cache = m_tail.load(std::memory_order_acquire);
+        return BufferView<T>{slot(head), contiguous_from(head, m_tail_cache - head)};
+    }
+
+    /**
+     * @brief Release count elements obtained through read_view() (consumer only)
+     */
+    void commit_read(size_type count) noexcept {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        assert(count <= m_tail_cache - head && "SpscQueue: commit past ready elements");
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_type i = 0; i < count; ++i) {
+                slot(head + i)->~T();
+            }
+        }
+        m_head.store(head + count, std::memory_order_release);
+    }
+
+    /** @brief Get an approximate element count (exact when called by either side) */
+    std::size_t size_approx() const noexcept {
+        const size_type head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+    /** @brief Check whether the queue looks empty */
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+
+   private:
+    static constexpr size_type mask = N - 1;
+
+    T* slot(size_type counter) noexcept {
+        return reinterpret_cast<T*>(m_storage) + (counter & mask);
+    }
+
+    /// How many of n slots starting at counter fit before the buffer wraps
+    static size_type contiguous_from(size_type counter, size_type n) noexcept {
+        const size_type to_end = N - (counter & mask);
+        return n < to_end ? n : to_end;
+    }
+
+    /// Producer-owned: next slot to write
+    alignas(cache_line) std::atomic<size_type> m_tail;
+    /// Producer-owned: last head value seen by the producer
+    size_type m_head_cache;
+    /// Consumer-owned: next slot to read
+    alignas(cache_line) std::atomic<size_type> m_head;
+    /// Consumer-owned: last tail value seen by the consumer
+    size_type m_tail_cache;
+    /// Inline slot storage, on its own cache lines
+    alignas(cache_line) unsigned char m_storage[N * sizeof(T)];
+};
@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "spsc_queue.hpp"
+
+struct Sample {
+    std::uint32_t sequence;
+    float value;
+};
+
+int main() {
+    // Example 1: Single-threaded push/pop
+    std::cout << "Example 1: Basic push/pop\n";
+    SpscQueue<std::string, 4> names;
+    names.try_push("alpha");
+    names.try_emplace(3, 'b');
+    std::string name;
+    while (names.try_pop(name)) {
+        std::cout << name << " ";
+    }
+    std::cout << "\n\n";
+
+    // Example 2: Producer thread and consumer thread hand off samples in batches
+    std::cout << "Example 2: Zero-copy batched pipeline\n";
+    constexpr std::uint32_t total = 100000;
+    static SpscQueue<Sample, 1024> queue;
+
+    std::thread producer([] {
+        std::uint32_t next = 0;
+        while (next < total) {
+            auto slots = queue.write_view();
+            std::size_t n = 0;
+            for (; n < slots.m_size && next < total; ++n, ++next) {
+                slots.m_data[n] = Sample{next, next * 0.5f};
+            }
+            queue.commit_write(n);
+        }
+    });
+
+    std::uint32_t received = 0;
+    std::uint32_t batches = 0;
+    bool in_order = true;
+    while (received < total) {
+        auto batch = queue.read_view();
+        for (const Sample& s : batch) {
+            in_order = in_order && s.sequence == received;
+            ++received;
+        }
+        if (batch.m_size != 0) {
+            ++batches;
+        }
+        queue.commit_read(batch.m_size);
+    }
+    producer.join();
+    std::cout << "Received " << received << " samples in " << batches << " batches, "
+              << (in_order ? "in order" : "OUT OF ORDER") << "\n\n";
+
+    // Example 3: Copying batches in and out
+    std::cout << "Example 3: try_push_n/try_pop_n\n";
+    SpscQueue<int, 8> small;
+    int in[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::cout << "Pushed " << small.try_push_n(in, 10) << " of 10\n";
+    int out[6] = {};
+    std::cout << "Popped " << small.try_pop_n(out, 6) << ", " << small.size_approx()
+              << " left\n";
+
+    return 0;
+}
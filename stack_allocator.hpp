@@ -1,14 +1,130 @@
 #ifndef STACK_ALLOCATOR_HPP
 #define STACK_ALLOCATOR_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
 #include <memory>
+#include <new>
 #include <type_traits>
-#include <vector>
+#include <utility>
+
+#include "buffer_view.hpp"
+#include "stack_stats.hpp"
+
+/**
+ * @brief What StackAllocator does when its buffer cannot satisfy a request
+ *
+ * A policy is a stateless type with two static functions:
+ * - `void* overflow(std::size_t bytes, std::size_t align)` returns replacement memory or
+ *   nullptr, or does not return at all
+ * - `void release(void* p, std::size_t bytes, std::size_t align) noexcept` frees memory
+ *   that overflow() returned
+ *
+ * and a `static constexpr bool allocates` saying whether overflow() can return memory.
+ * The policy is chosen at compile time, so the in-buffer fast path is unchanged and
+ * deallocate() only checks for foreign pointers when `allocates` is true.
+ */
+namespace overflow_policy {
+
+/// Assert in debug builds and return nullptr (the default)
+struct ReturnNull {
+    static constexpr bool allocates = false;
+
+    static void* overflow(std::size_t, std::size_t) noexcept {
+        assert(false && "StackAllocator: buffer overflow");
+        return nullptr;
+    }
+    static void release(void*, std::size_t, std::size_t) noexcept {}
+};
+
+/// Throw std::bad_alloc, as std::allocator would
+struct Throw {
+    static constexpr bool allocates = false;
+
+    [[noreturn]] static void* overflow(std::size_t, std::size_t) { throw std::bad_alloc(); }
+    static void release(void*, std::size_t, std::size_t) noexcept {}
+};
+
+/**
+ * @brief Call Handler(bytes), then throw std::bad_alloc if it returns
+ *
+ * Meant for fail-fast code: the handler typically logs the request and aborts. A handler
+ * that only logs, or throws its own exception, still never lets a container see nullptr.
+ */
+template <void (*Handler)(std::size_t bytes)>
+struct Call {
+    static constexpr bool allocates = false;
+
+    [[noreturn]] static void* overflow(std::size_t bytes, std::size_t) {
+        Handler(bytes);
+        throw std::bad_alloc();
+    }
+    static void release(void*, std::size_t, std::size_t) noexcept {}
+};
+
+/**
+ * @brief Fall back to the global (aligned) operator new
+ *
+ * The buffer still serves every request that fits; only the overflow goes to the heap,
+ * and deallocate() hands such blocks back to operator delete. Each block then carries a
+ * small ownership tag (one pointer, rounded up to the allocation alignment), so a
+ * container moved from another instance frees correctly.
+ */
+struct Heap {
+    static constexpr bool allocates = true;
+
+    static void* overflow(std::size_t bytes, std::size_t align) {
+        return ::operator new(bytes, std::align_val_t{align});
+    }
+    static void release(void* p, std::size_t bytes, std::size_t align) noexcept {
+        ::operator delete(p, bytes, std::align_val_t{align});
+    }
+};
+
+}  // namespace overflow_policy
 
 namespace stack_alloc_internal {
 
+/**
+ * @brief Round offset up to the next multiple of align
+ *
+ * @param offset Value to round
+ * @param align Alignment, must be a power of two
+ */
+constexpr std::size_t align_up(std::size_t offset, std::size_t align) noexcept {
+    return (offset + align - 1) & ~(align - 1);
+}
+
+/**
+ * @brief Smallest unsigned type that can count from 0 to N
+ *
+ * Used for the size field of inline containers so that, e.g., a StackVector of 32 bytes
+ * carries a 1-byte count instead of an 8-byte one.
+ */
+template <std::size_t N>
+using size_type_for = std::conditional_t<
+    N <= UINT8_MAX, std::uint8_t,
+    std::conditional_t<N <= UINT16_MAX, std::uint16_t,
+                       std::conditional_t<N <= UINT32_MAX, std::uint32_t, std::size_t>>>;
+
+/**
+ * @brief Alignment of a fixed buffer holding T
+ *
+ * Never weaker than alignof(T), so elements constructed in the buffer are always
+ * properly aligned wherever the owning object is placed. An explicit Align can only
+ * raise it. AlignAccess is accepted for compatibility and no longer lowers it.
+ */
+template <typename T, bool AlignAccess, std::size_t Align>
+constexpr std::size_t buffer_alignment() noexcept {
+    static_assert((Align & (Align - 1)) == 0, "Align must be zero or a power of two");
+    (void)AlignAccess;
+    return Align > alignof(T) ? Align : alignof(T);
+}
+
 /**
  * @brief A custom allocator that uses a fixed-size buffer for allocations.
  *
@@ -17,16 +133,33 @@ namespace stack_alloc_internal {
  *
  * @tparam T The type of objects to allocate
  * @tparam N The size of the buffer in bytes
- * @tparam AlignAccess Whether to enforce alignment (default: true)
+ * @tparam AlignAccess Kept for compatibility; the buffer is always aligned for T
+ *                     (default: true)
+ * @tparam Align Explicit buffer and per-allocation alignment in bytes, e.g. 32 or 64 for
+ *               SIMD loads (default: 0, alignof(T))
+ * @tparam Overflow What to do when the buffer is full; see overflow_policy
+ *                  (default: overflow_policy::ReturnNull)
+ *
+ * Example usage:
+ * @code
+ * // Batch job: spill to the heap instead of failing
+ * using BatchAlloc =
+ *     stack_alloc_internal::StackAllocator<Row, 64 * 1024, true, 0, overflow_policy::Heap>;
+ * std::vector<Row, BatchAlloc> rows;
+ *
+ * // Latency-critical path: a full buffer is a bug, fail loudly
+ * stack_alloc_internal::StackAllocator<Order, 4096, true, 0, overflow_policy::Throw> orders;
+ * @endcode
  *
- * @note When AlignAccess is false, allocations are packed without padding for maximum space
- * efficiency
- * @note This allocator does not throw exceptions; allocation failures return nullptr
+ * @note The buffer and every allocation are aligned to at least alignof(T)
+ * @note With the default policy this allocator does not throw; allocation failures
+ *       return nullptr
  * @note Each allocator instance owns its own buffer
  * @note This is an implementation detail - use StackVector for the public interface
  * @warning This class is in the detail namespace and should not be used directly
  */
-template <typename T, std::size_t N, bool AlignAccess = true>
+template <typename T, std::size_t N, bool AlignAccess = true, std::size_t Align = 0,
+          typename Overflow = overflow_policy::ReturnNull>
 class StackAllocator {
    public:
     using value_type = T;
@@ -39,9 +172,13 @@ class StackAllocator {
 
     template <typename U>
     struct rebind {
-        using other = StackAllocator<U, N, AlignAccess>;
+        using other = StackAllocator<U, N, AlignAccess, Align, Overflow>;
     };
 
+    /// Alignment of the buffer and of every allocation offset
+    static constexpr size_type alignment =
+        stack_alloc_internal::buffer_alignment<T, AlignAccess, Align>();
+
     /**
      * @brief Default constructor
      *
@@ -70,31 +207,51 @@ class StackAllocator {
      * @param other The allocator to convert from
      */
     template <typename U>
-    StackAllocator(const StackAllocator<U, N, AlignAccess>&) noexcept : m_offset(0) {}
+    StackAllocator(const StackAllocator<U, N, AlignAccess, Align, Overflow>&) noexcept
+        : m_offset(0) {}
 
     /**
      * @brief Allocate memory for n objects of type T
      *
-     * Allocates memory from the fixed-size buffer. If AlignAccess is true,
-     * the allocation will be properly aligned for type T.
+     * Allocates memory from the fixed-size buffer, aligned for T, or to Align bytes if
+     * Align is set.
      *
      * @param n Number of objects to allocate
-     * @return Pointer to allocated memory, or nullptr if allocation fails
+     * @return Pointer to allocated memory, or whatever the Overflow policy returns when
+     *         the buffer is full
      *
-     * @note This function never throws. On failure, it asserts in debug builds and returns nullptr.
+     * @note With the default policy this function never throws. On failure, it asserts in
+     *       debug builds and returns nullptr.
      * @note Allocations are made sequentially from the buffer
      */
-    pointer allocate(size_type n) noexcept {
-        const size_type bytes_needed = n * sizeof(T);
+    pointer allocate(size_type n) noexcept(noexcept(Overflow::overflow(0, 0))) {
+        const size_type bytes_needed = n * sizeof(T) + tag_size;
+        size_type start = m_offset;
+        if constexpr (alignment > 1) {
+            start = stack_alloc_internal::align_up(start, alignment);
+        }
 
-        if (m_offset + bytes_needed > N) {
-            // Out of buffer space - return nullptr instead of throwing
-            assert(false && "StackAllocator: buffer overflow");
-            return nullptr;
+        if (start + bytes_needed > N) {
+            if constexpr (stack_stats::enabled) {
+                stats().failed_allocations.fetch_add(1, std::memory_order_relaxed);
+            }
+            void* block = Overflow::overflow(bytes_needed, overflow_alignment);
+            if constexpr (Overflow::allocates) {
+                if (block != nullptr) {
+                    return tag(static_cast<char*>(block), nullptr);
+                }
+            }
+            return static_cast<pointer>(block);
         }
 
-        pointer result = reinterpret_cast<pointer>(reinterpret_cast<char*>(&m_buffer) + m_offset);
-        m_offset += bytes_needed;
+        char* block = reinterpret_cast<char*>(&m_buffer) + start;
+        m_offset = start + bytes_needed;
+        pointer result = tag(block, reinterpret_cast<char*>(&m_buffer));
+
+        if constexpr (stack_stats::enabled) {
+            stats().allocations.fetch_add(1, std::memory_order_relaxed);
+            stats().record_peak(m_offset);
+        }
 
         return result;
     }
@@ -106,6 +263,10 @@ class StackAllocator {
      * allocation (stack-like behavior). Otherwise, the space remains used until the allocator
      * is destroyed.
      *
+     * With an allocating Overflow policy, blocks returned by the policy go back to it, and
+     * blocks in another allocator's buffer (a container moved from a source that used a
+     * different copy of this allocator) are left alone.
+     *
      * @param p Pointer to the memory to deallocate
      * @param n Number of objects being deallocated
      *
@@ -117,16 +278,48 @@ class StackAllocator {
         // We could implement a simple stack-like deallocation if the pointer
         // matches the last allocation
 
-        const char* ptr_as_char = reinterpret_cast<const char*>(p);
-        const size_type bytes = n * sizeof(T);
+        const char* ptr_as_char = reinterpret_cast<const char*>(p) - tag_size;
+        const size_type bytes = n * sizeof(T) + tag_size;
         char* buffer_ptr = reinterpret_cast<char*>(&m_buffer);
 
+        if constexpr (Overflow::allocates) {
+            const char* owner;
+            std::memcpy(&owner, ptr_as_char, sizeof(owner));
+            if (owner == nullptr) {
+                Overflow::release(const_cast<char*>(ptr_as_char), bytes, overflow_alignment);
+                return;
+            }
+            if (owner != buffer_ptr) {
+                return;  // lives in another copy's buffer, which reclaims it on destruction
+            }
+        }
+
         // If this was the last allocation, we can reclaim the space
         if (ptr_as_char + bytes == buffer_ptr + m_offset) {
             m_offset = ptr_as_char - buffer_ptr;
+        } else if constexpr (stack_stats::enabled) {
+            stats().wasted_bytes.fetch_add(bytes, std::memory_order_relaxed);
         }
     }
 
+    /**
+     * @brief Record the current allocation offset
+     *
+     * @return Marker that can later be passed to rewind()
+     */
+    size_type mark() const noexcept { return m_offset; }
+
+    /**
+     * @brief Release everything allocated since mark() in O(1)
+     *
+     * @param marker Value previously returned by mark()
+     * @warning Objects still living in the released region are not destroyed
+     */
+    void rewind(size_type marker) noexcept {
+        assert(marker <= m_offset && "StackAllocator: rewind past current offset");
+        m_offset = marker;
+    }
+
     /**
      * @brief Compare allocators for equality
      *
@@ -135,11 +328,13 @@ class StackAllocator {
      * @tparam U Value type of the other allocator
      * @tparam M Buffer size of the other allocator
      * @tparam A AlignAccess setting of the other allocator
+     * @tparam L Align setting of the other allocator
+     * @tparam O Overflow policy of the other allocator
      * @param other The allocator to compare with
      * @return true if allocators share the same buffer, false otherwise
      */
-    template <typename U, std::size_t M, bool A>
-    bool operator==(const StackAllocator<U, M, A>& other) const noexcept {
+    template <typename U, std::size_t M, bool A, std::size_t L, typename O>
+    bool operator==(const StackAllocator<U, M, A, L, O>& other) const noexcept {
         return &m_buffer == &other.m_buffer;
     }
 
@@ -149,59 +344,211 @@ class StackAllocator {
      * @tparam U Value type of the other allocator
      * @tparam M Buffer size of the other allocator
      * @tparam A AlignAccess setting of the other allocator
+     * @tparam L Align setting of the other allocator
+     * @tparam O Overflow policy of the other allocator
      * @param other The allocator to compare with
      * @return true if allocators don't share the same buffer, false otherwise
      */
-    template <typename U, std::size_t M, bool A>
-    bool operator!=(const StackAllocator<U, M, A>& other) const noexcept {
+    template <typename U, std::size_t M, bool A, std::size_t L, typename O>
+    bool operator!=(const StackAllocator<U, M, A, L, O>& other) const noexcept {
         return !(*this == other);
     }
 
+    /**
+     * @brief Get the usage counters shared by all allocators of this instantiation
+     * @note Only meaningful when built with STACK_VEC_STATS=1
+     */
+    static stack_stats::Counters& stats() noexcept {
+        return stack_stats::counters_for<StackAllocator>(N);
+    }
+
     // Allow access to private members for rebind
-    template <typename, std::size_t, bool>
+    template <typename, std::size_t, bool, std::size_t, typename>
     friend class StackAllocator;
 
    private:
-    /// Fixed-size buffer for allocations (aligned or unaligned based on AlignAccess)
-    typename std::conditional<AlignAccess, typename std::aligned_storage<N, alignof(T)>::type,
-                              char[N]>::type m_buffer;
+    /// Alignment requested from the Overflow policy (at least alignof(T))
+    static constexpr size_type overflow_alignment = alignment > alignof(T) ? alignment : alignof(T);
+
+    /**
+     * @brief Bytes in front of each block that record where it came from
+     *
+     * Only allocating policies need it: the tag holds the address of the buffer the
+     * block was carved from, or nullptr for blocks from Overflow::overflow(), so
+     * deallocate() does not have to infer ownership from which copy it is called on.
+     */
+    static constexpr size_type tag_size =
+        Overflow::allocates ? stack_alloc_internal::align_up(sizeof(char*), overflow_alignment)
+                            : 0;
+
+    /// Write the ownership tag at the start of block and return the element pointer
+    static pointer tag(char* block, const char* owner) noexcept {
+        if constexpr (Overflow::allocates) {
+            std::memcpy(block, &owner, sizeof(owner));
+        } else {
+            (void)owner;
+        }
+        return reinterpret_cast<pointer>(block + tag_size);
+    }
+
+    /// Fixed-size buffer for allocations (aligned for T, or to Align)
+    alignas(alignment) char m_buffer[N];
     /// Current offset into the buffer for next allocation
     size_type m_offset;
 };
 
+/**
+ * @brief Destroy n objects starting at first
+ *
+ * Compiles to nothing for trivially destructible types.
+ */
+template <typename T>
+void destroy_n(T* first, std::size_t n) noexcept {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        for (std::size_t i = 0; i < n; ++i) {
+            first[i].~T();
+        }
+    }
+}
+
+/**
+ * @brief Move n objects from src into uninitialized dst and destroy the sources
+ *
+ * Trivially copyable types are relocated with a single memcpy. Other types are
+ * move-constructed element by element and the moved-from objects are destroyed.
+ *
+ * @note src and dst must not overlap
+ */
+template <typename T>
+void relocate_n(T* dst, T* src, std::size_t n) noexcept(
+    std::is_nothrow_move_constructible<T>::value) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+/**
+ * @brief Copy-construct n objects from src into uninitialized dst
+ *
+ * Trivially copyable types are copied with a single memcpy; other types are
+ * copy-constructed element by element. If a copy throws, the objects already
+ * constructed in dst are destroyed before the exception propagates.
+ *
+ * @note src and dst must not overlap
+ */
+template <typename T>
+void copy_n(T* dst, const T* src, std::size_t n) noexcept(
+    std::is_nothrow_copy_constructible<T>::value) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+    } else {
+        std::size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                ::new (static_cast<void*>(dst + i)) T(src[i]);
+            }
+        } catch (...) {
+            destroy_n(dst, i);
+            throw;
+        }
+    }
+}
+
 }  // namespace stack_alloc_internal
 
 /**
- * @brief Helper wrapper around std::vector with StackAllocator
+ * @brief RAII checkpoint that rewinds an allocator or arena when the scope exits
+ *
+ * Records the current offset on construction and restores it on destruction, dropping
+ * every allocation made in between in O(1) without individual deallocations. Works with
+ * any type providing mark() and rewind(), such as StackAllocator and ArenaResource.
+ *
+ * Example usage:
+ * @code
+ * for (const auto& token : tokens) {
+ *     RewindScope scope{arena};
+ *     std::vector<char, ArenaAllocator<char>> scratch{ArenaAllocator<char>{arena}};
+ *     // ... per-token scratch work; scratch must be destroyed before scope
+ * }
+ * @endcode
+ *
+ * @tparam Resource The allocator or arena type to checkpoint
+ */
+template <typename Resource>
+class RewindScope {
+   public:
+    /** @brief Record the current offset of resource */
+    explicit RewindScope(Resource& resource) noexcept
+        : m_resource(resource), m_marker(resource.mark()) {}
+
+    RewindScope(const RewindScope&) = delete;
+    RewindScope& operator=(const RewindScope&) = delete;
+
+    /** @brief Rewind resource to the recorded offset */
+    ~RewindScope() { m_resource.rewind(m_marker); }
+
+    /** @brief Get the recorded offset */
+    typename Resource::size_type marker() const noexcept { return m_marker; }
+
+   private:
+    /// The allocator or arena being checkpointed
+    Resource& m_resource;
+    /// Offset recorded at construction
+    typename Resource::size_type m_marker;
+};
+
+/**
+ * @brief Fixed-capacity vector with inline element storage
  *
- * This class provides a convenient interface for using std::vector with a fixed-size
- * buffer allocator. It automatically reserves the full capacity on construction to
- * prevent reallocations.
+ * Elements live directly inside the object, so a StackVector is just its buffer
+ * plus a size counter: there is no separate allocator and no heap or data pointer.
+ * Moving or swapping relocates the elements into the destination's own buffer;
+ * trivially copyable types are relocated with memcpy.
  *
  * @tparam T The type of elements in the vector
  * @tparam N The maximum number of elements (not bytes)
- * @tparam AlignAccess Whether to enforce alignment (default: false for max efficiency)
+ * @tparam AlignAccess Kept for compatibility; the buffer is always aligned for T
+ *                     (default: false)
+ * @tparam Align Explicit buffer alignment in bytes, e.g. 32 or 64 so SIMD kernels can use
+ *               aligned loads on data() (default: 0, alignof(T))
  *
- * @note This class is not copyable (copy constructor and assignment are deleted)
- * @note Move operations are supported
- * @note Capacity is fixed at N elements
+ * @note Copies duplicate only the size() live elements (one memcpy for trivially
+ *       copyable types)
+ * @note Move operations are supported and leave the source empty
+ * @note Capacity is fixed at N elements; exceeding it asserts in debug builds
  */
-template <typename T, std::size_t N, bool AlignAccess = false>
+template <typename T, std::size_t N, bool AlignAccess = false, std::size_t Align = 0>
 class StackVector {
    public:
-    using allocator_type = stack_alloc_internal::StackAllocator<T, N * sizeof(T), AlignAccess>;
-    using vector_type = std::vector<T, allocator_type>;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /// Alignment of data() in bytes
+    static constexpr size_type alignment =
+        stack_alloc_internal::buffer_alignment<T, AlignAccess, Align>();
 
     /**
      * @brief Default constructor
      *
-     * Creates a StackVector and reserves the full capacity upfront to prevent
-     * reallocations that would exceed the fixed buffer size.
+     * Creates an empty StackVector. No element is constructed.
      */
-    StackVector() : m_alloc{}, m_vec{m_alloc} {
-        // Reserve the full capacity upfront to avoid reallocations
-        m_vec.reserve(N);
-    }
+    StackVector() noexcept : m_size(0) {}
 
     /**
      * @brief Constructor from initializer list
@@ -210,8 +557,11 @@ class StackVector {
      *
      * @param init Initializer list of elements
      */
-    StackVector(std::initializer_list<T> init) : m_alloc{}, m_vec{init, m_alloc} {
-        // Vector is already constructed with the initializer list elements
+    StackVector(std::initializer_list<T> init) : m_size(0) {
+        assert(init.size() <= N && "StackVector: initializer list exceeds capacity");
+        for (const T& value : init) {
+            emplace_back(value);
+        }
     }
 
     /**
@@ -226,115 +576,391 @@ class StackVector {
      *       StackVector<int, 10> vec(5, 42);  // 5 copies of 42
      *       StackVector<int, 10> vec{5, 42};  // initializer_list with 2 elements!
      */
-    StackVector(std::size_t count, const T& value) : m_alloc{}, m_vec{count, value, m_alloc} {
-        // Vector is already constructed with count copies of value
+    StackVector(std::size_t count, const T& value) : m_size(0) {
+        assert(count <= N && "StackVector: fill count exceeds capacity");
+        for (std::size_t i = 0; i < count; ++i) {
+            emplace_back(value);
+        }
     }
 
-    /// Copy constructor is deleted (buffer cannot be efficiently copied)
-    StackVector(const StackVector&) = delete;
-    /// Copy assignment is deleted (buffer cannot be efficiently copied)
-    StackVector& operator=(const StackVector&) = delete;
+    /**
+     * @brief Copy constructor
+     *
+     * Copies only the size() live elements: a single memcpy for trivially copyable
+     * types, element-wise copy construction otherwise.
+     */
+    StackVector(const StackVector& other) noexcept(
+        std::is_nothrow_copy_constructible<T>::value)
+        : m_size(0) {
+        insert_range(other.data(), other.m_size);
+    }
 
-    /// Move constructor is allowed
-    StackVector(StackVector&&) = default;
-    /// Move assignment is allowed
-    StackVector& operator=(StackVector&&) = default;
+    /**
+     * @brief Copy assignment
+     *
+     * Trivially copyable types are copied with a single memcpy of size() elements.
+     * Otherwise the common prefix is copy-assigned, then the extra elements of other
+     * are copy-constructed or this vector's surplus elements are destroyed.
+     */
+    StackVector& operator=(const StackVector& other) noexcept(
+        std::is_nothrow_copy_constructible<T>::value &&
+        std::is_nothrow_copy_assignable<T>::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if constexpr (stack_stats::enabled) {
+                if (other.m_size > m_size) {
+                    record_growth(other.m_size - m_size);
+                }
+            }
+            if (other.m_size != 0) {
+                std::memcpy(static_cast<void*>(data()), other.data(), other.m_size * sizeof(T));
+            }
+            m_size = other.m_size;
+        } else if (other.m_size > m_size) {
+            const size_type common = m_size;
+            std::copy(other.data(), other.data() + common, data());
+            insert_range(other.data() + common, other.m_size - common);
+        } else {
+            std::copy(other.data(), other.data() + other.m_size, data());
+            stack_alloc_internal::destroy_n(data() + other.m_size, m_size - other.m_size);
+            m_size = other.m_size;
+        }
+        return *this;
+    }
 
     /**
-     * @brief Get reference to the underlying std::vector
-     * @return Reference to the internal vector
+     * @brief Move constructor
+     *
+     * Relocates the elements of other into this object's buffer and leaves other empty.
      */
-    vector_type& get() noexcept { return m_vec; }
+    StackVector(StackVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : m_size(0) {
+        stack_alloc_internal::relocate_n(data(), other.data(), other.m_size);
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
 
     /**
-     * @brief Get const reference to the underlying std::vector
-     * @return Const reference to the internal vector
+     * @brief Move assignment
+     *
+     * Destroys the current elements, then relocates the elements of other into this
+     * object's buffer and leaves other empty.
      */
-    const vector_type& get() const noexcept { return m_vec; }
+    StackVector& operator=(StackVector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            stack_alloc_internal::relocate_n(data(), other.data(), other.m_size);
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    /// Destroys all elements
+    ~StackVector() { clear(); }
 
-    // Convenience forwarding methods
+    /**
+     * @brief Exchange contents with another StackVector
+     *
+     * The common prefix is swapped element by element and the remaining tail of the
+     * longer vector is relocated into the shorter one.
+     */
+    void swap(StackVector& other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                           std::is_nothrow_swappable<T>::value) {
+        StackVector* shorter = m_size < other.m_size ? this : &other;
+        StackVector* longer = m_size < other.m_size ? &other : this;
+        const size_type common = shorter->m_size;
+
+        using std::swap;
+        for (size_type i = 0; i < common; ++i) {
+            swap(data()[i], other.data()[i]);
+        }
+        stack_alloc_internal::relocate_n(shorter->data() + common, longer->data() + common,
+                                         longer->m_size - common);
+        const count_type tmp = m_size;
+        m_size = other.m_size;
+        other.m_size = tmp;
+    }
 
     /** @brief Add element to the end (copy) */
-    void push_back(const T& value) noexcept(
-        noexcept(std::declval<vector_type>().push_back(value))) {
-        m_vec.push_back(value);
+    void push_back(const T& value) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        emplace_back(value);
     }
 
     /** @brief Add element to the end (move) */
-    void push_back(T&& value) noexcept(
-        noexcept(std::declval<vector_type>().push_back(std::move(value)))) {
-        m_vec.push_back(std::move(value));
+    void push_back(T&& value) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        emplace_back(std::move(value));
     }
 
     /**
      * @brief Construct element in-place at the end
      * @tparam Args Types of arguments to forward to T's constructor
      * @param args Arguments to forward to T's constructor
+     * @return Reference to the new element
      */
     template <typename... Args>
-    void emplace_back(Args&&... args) noexcept(
-        noexcept(std::declval<vector_type>().emplace_back(std::forward<Args>(args)...))) {
-        m_vec.emplace_back(std::forward<Args>(args)...);
+    T& emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value) {
+        if constexpr (stack_stats::enabled) {
+            record_growth(1);
+        }
+        assert(m_size < N && "StackVector: capacity exceeded");
+        T* slot = ::new (static_cast<void*>(data() + m_size)) T(std::forward<Args>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    /** @brief Remove the last element (must not be empty) */
+    void pop_back() noexcept {
+        assert(m_size > 0 && "StackVector: pop_back on empty vector");
+        --m_size;
+        stack_alloc_internal::destroy_n(data() + m_size, 1);
     }
 
     /**
-     * @brief Insert multiple elements from array (for integer types only)
+     * @brief Construct element in-place before pos, shifting later elements up
      *
-     * This method is specifically for integer types and allows inserting
-     * multiple elements from a C-style array in one call.
+     * Trivially copyable types are shifted with a single memmove.
      *
-     * @param data Pointer to array of elements to insert
-     * @param count Number of elements to insert
+     * @param pos Position to insert before (begin() to end())
+     * @param args Arguments to forward to T's constructor
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_type idx = static_cast<size_type>(pos - data());
+        if (idx == m_size) {
+            emplace_back(std::forward<Args>(args)...);
+            return data() + idx;
+        }
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            T value(std::forward<Args>(args)...);
+            if constexpr (stack_stats::enabled) {
+                record_growth(1);
+            }
+            assert(m_size < N && "StackVector: capacity exceeded");
+            std::memmove(static_cast<void*>(data() + idx + 1), data() + idx,
+                         (m_size - idx) * sizeof(T));
+            ::new (static_cast<void*>(data() + idx)) T(value);
+            ++m_size;
+        } else {
+            T value(std::forward<Args>(args)...);
+            emplace_back(std::move(back()));
+            std::move_backward(data() + idx, data() + m_size - 2, data() + m_size - 1);
+            data()[idx] = std::move(value);
+        }
+        return data() + idx;
+    }
+
+    /** @brief Insert a copy of value before pos */
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+
+    /** @brief Insert value before pos by move */
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    /**
+     * @brief Remove the element at pos, shifting later elements down
+     * @return Iterator to the element that followed the removed one
+     */
+    iterator erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        const size_type idx = static_cast<size_type>(pos - data());
+        std::move(data() + idx + 1, data() + m_size, data() + idx);
+        pop_back();
+        return data() + idx;
+    }
+
+    /**
+     * @brief Append multiple elements from an array
+     *
+     * Trivially copyable types are appended with a single memcpy; other types are
+     * copy-constructed element by element.
+     *
+     * @param data Pointer to array of elements to append
+     * @param count Number of elements to append
+     */
+    void insert_range(const T* data, std::size_t count) noexcept(
+        std::is_nothrow_copy_constructible<T>::value) {
+        if constexpr (stack_stats::enabled) {
+            record_growth(count);
+        }
+        assert(m_size + count <= N && "StackVector: capacity exceeded");
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(this->data() + m_size), data, count * sizeof(T));
+            }
+            m_size = static_cast<count_type>(m_size + count);
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(this->data() + m_size)) T(data[i]);
+                ++m_size;
+            }
+        }
+    }
+
+    /**
+     * @brief Append all elements of a view
+     * @param view Elements to append; either a BufferView<T> or a BufferView<const T>
+     */
+    template <typename U,
+              typename = std::enable_if_t<std::is_same<std::remove_const_t<U>, T>::value>>
+    void insert_range(BufferView<U> view) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        insert_range(static_cast<const T*>(view.m_data), view.m_size);
+    }
+
+    /**
+     * @brief Grow by count elements without initializing them
+     *
+     * Returns the new tail so a producer such as recv() or a decoder can write into it
+     * directly, skipping the value-initialization a normal resize would do.
+     *
+     * @code
+     * auto tail = packet.append_uninitialized(1500);
+     * ssize_t got = recv(fd, tail.begin(), tail.m_size * sizeof(char), 0);
+     * packet.resize_uninitialized(packet.size() - tail.m_size + (got > 0 ? got : 0));
+     * @endcode
      *
-     * @note Only available when T is an integral type
+     * @param count Number of elements to add
+     * @return Writable view over the added (uninitialized) elements
+     * @note Only available when T is trivially copyable
      */
     template <typename U = T>
-    std::enable_if_t<std::is_integral<U>::value, void> insert_range(const T* data,
-                                                                    std::size_t count) noexcept {
-        for (std::size_t i = 0; i < count; ++i) {
-            m_vec.push_back(data[i]);
+    std::enable_if_t<std::is_trivially_copyable<U>::value, BufferView<T>> append_uninitialized(
+        std::size_t count) noexcept {
+        if constexpr (stack_stats::enabled) {
+            record_growth(count);
+        }
+        assert(m_size + count <= N && "StackVector: capacity exceeded");
+        T* tail = data() + m_size;
+        m_size = static_cast<count_type>(m_size + count);
+        return BufferView<T>{tail, count};
+    }
+
+    /**
+     * @brief Set the size to n without initializing new elements
+     *
+     * Shrinking simply drops the tail; growing behaves like append_uninitialized().
+     *
+     * @param n New size (at most N)
+     * @return Writable view over the added elements (empty when shrinking)
+     * @note Only available when T is trivially copyable
+     */
+    template <typename U = T>
+    std::enable_if_t<std::is_trivially_copyable<U>::value, BufferView<T>> resize_uninitialized(
+        std::size_t n) noexcept {
+        if (n <= m_size) {
+            m_size = static_cast<count_type>(n);
+            return BufferView<T>{data() + n, 0};
         }
+        return append_uninitialized(n - m_size);
     }
 
     /** @brief Access element at index (unchecked) */
-    T& operator[](std::size_t idx) noexcept { return m_vec[idx]; }
+    T& operator[](std::size_t idx) noexcept { return data()[idx]; }
     /** @brief Access element at index (unchecked, const) */
-    const T& operator[](std::size_t idx) const noexcept { return m_vec[idx]; }
+    const T& operator[](std::size_t idx) const noexcept { return data()[idx]; }
+
+    /** @brief Access the first element (must not be empty) */
+    T& front() noexcept { return data()[0]; }
+    /** @brief Access the first element (must not be empty, const) */
+    const T& front() const noexcept { return data()[0]; }
+    /** @brief Access the last element (must not be empty) */
+    T& back() noexcept { return data()[m_size - 1]; }
+    /** @brief Access the last element (must not be empty, const) */
+    const T& back() const noexcept { return data()[m_size - 1]; }
 
     /** @brief Get iterator to beginning */
-    typename vector_type::iterator begin() noexcept { return m_vec.begin(); }
+    iterator begin() noexcept { return data(); }
     /** @brief Get iterator to end */
-    typename vector_type::iterator end() noexcept { return m_vec.end(); }
+    iterator end() noexcept { return data() + m_size; }
     /** @brief Get const iterator to beginning */
-    typename vector_type::const_iterator begin() const noexcept { return m_vec.begin(); }
+    const_iterator begin() const noexcept { return data(); }
     /** @brief Get const iterator to end */
-    typename vector_type::const_iterator end() const noexcept { return m_vec.end(); }
+    const_iterator end() const noexcept { return data() + m_size; }
     /** @brief Get const iterator to beginning */
-    typename vector_type::const_iterator cbegin() const noexcept { return m_vec.cbegin(); }
+    const_iterator cbegin() const noexcept { return data(); }
     /** @brief Get const iterator to end */
-    typename vector_type::const_iterator cend() const noexcept { return m_vec.cend(); }
+    const_iterator cend() const noexcept { return data() + m_size; }
 
     /** @brief Get number of elements */
-    std::size_t size() const noexcept { return m_vec.size(); }
+    std::size_t size() const noexcept { return m_size; }
     /** @brief Get capacity (always N) */
     static constexpr std::size_t capacity() { return N; }
     /** @brief Check if empty */
-    bool empty() const noexcept { return m_vec.empty(); }
+    bool empty() const noexcept { return m_size == 0; }
+    /** @brief Check if size has reached capacity */
+    bool full() const noexcept { return m_size == N; }
     /** @brief Remove all elements */
-    void clear() noexcept { m_vec.clear(); }
-    /** @brief Reserve capacity (no-op if n <= N) */
-    void reserve(std::size_t n) { m_vec.reserve(n); }
+    void clear() noexcept {
+        stack_alloc_internal::destroy_n(data(), m_size);
+        m_size = 0;
+    }
+    /** @brief Reserve capacity (no-op; asserts n <= N) */
+    void reserve(std::size_t n) noexcept {
+        (void)n;
+        assert(n <= N && "StackVector: reserve beyond fixed capacity");
+    }
 
     /** @brief Get pointer to underlying data */
-    T* data() noexcept { return m_vec.data(); }
+    T* data() noexcept { return reinterpret_cast<T*>(m_storage); }
     /** @brief Get const pointer to underlying data */
-    const T* data() const noexcept { return m_vec.data(); }
+    const T* data() const noexcept { return reinterpret_cast<const T*>(m_storage); }
+
+    /**
+     * @brief Get the usage counters shared by all vectors of this instantiation
+     *
+     * peak_bytes tracks the largest size() ever reached (in bytes), allocations the
+     * number of elements added and failed_allocations the attempts to exceed N.
+     *
+     * @note Only meaningful when built with STACK_VEC_STATS=1
+     */
+    static stack_stats::Counters& stats() noexcept {
+        return stack_stats::counters_for<StackVector>(N * sizeof(T));
+    }
 
    private:
-    /// The allocator instance that owns the fixed-size buffer
-    allocator_type m_alloc;
-    /// The vector using the stack allocator
-    vector_type m_vec;
+    using count_type = stack_alloc_internal::size_type_for<N>;
+
+    /// Record an attempt to add count elements (instrumented builds only)
+    void record_growth(size_type count) const noexcept {
+        stack_stats::Counters& counters = stats();
+        if (m_size + count > N) {
+            counters.failed_allocations.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        counters.allocations.fetch_add(count, std::memory_order_relaxed);
+        counters.record_peak((m_size + count) * sizeof(T));
+    }
+
+    /// Inline element storage (aligned for T, or to Align)
+    alignas(alignment) unsigned char m_storage[N * sizeof(T)];
+    /// Number of constructed elements, in the smallest type that can hold N
+    count_type m_size;
 };
 
+/**
+ * @brief Swap two StackVectors
+ */
+template <typename T, std::size_t N, bool AlignAccess, std::size_t Align>
+void swap(StackVector<T, N, AlignAccess, Align>& a,
+          StackVector<T, N, AlignAccess, Align>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+// Footprint guarantees: the size field is the smallest unsigned type that holds N, so
+// small vectors of bytes carry 1 or 2 bytes of bookkeeping instead of 8. The object is
+// always aligned for T, so the size field is padded up to alignof(T).
+static_assert(sizeof(StackVector<std::uint8_t, 32>) == 33, "1-byte size for N <= 255");
+static_assert(sizeof(StackVector<std::uint8_t, 255>) == 256, "1-byte size for N <= 255");
+static_assert(sizeof(StackVector<std::uint8_t, 256>) == 258, "2-byte size for N <= 65535");
+static_assert(sizeof(StackVector<std::uint16_t, 16>) == 34,
+              "1-byte size, padded to alignof(uint16_t)");
+static_assert(sizeof(StackVector<std::uint32_t, 8>) == 36,
+              "1-byte size, padded to alignof(uint32_t)");
+static_assert(sizeof(StackVector<double, 4>) == 40, "1-byte size, padded to alignof(double)");
+static_assert(alignof(StackVector<double, 4>) == alignof(double), "storage aligned for T");
+static_assert(alignof(StackVector<std::max_align_t, 4>) == alignof(std::max_align_t),
+              "storage aligned for T");
+
 #endif  // STACK_ALLOCATOR_HPP
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "stack_allocator.hpp"
+
+/**
+ * @brief Monotonic bump arena over a borrowed buffer
+ *
+ * Hands out memory sequentially from a single contiguous buffer that it does not own.
+ * Any number of containers can allocate from the same arena through ArenaAllocator
+ * handles, and everything is released at once with reset() or when the buffer goes away.
+ *
+ * Example usage:
+ * @code
+ * alignas(std::max_align_t) char buffer[4096];
+ * ArenaResource arena{buffer, sizeof(buffer)};
+ *
+ * std::vector<int, ArenaAllocator<int>> ids{ArenaAllocator<int>{arena}};
+ * std::map<int, int, std::less<int>, ArenaAllocator<std::pair<const int, int>>> index{
+ *     ArenaAllocator<std::pair<const int, int>>{arena}};
+ * @endcode
+ *
+ * @note This class does not throw exceptions; allocation failures return nullptr
+ * @note Only the most recent allocation is reclaimed by deallocate() (stack-like behavior)
+ * @note Not copyable or movable: allocator handles refer to the arena by address
+ */
+class ArenaResource {
+   public:
+    using size_type = std::size_t;
+
+    /// Default alignment for allocations that do not specify one
+    static constexpr size_type default_alignment = alignof(std::max_align_t);
+
+    /**
+     * @brief Construct an arena over an existing buffer
+     *
+     * @param buffer Start of the buffer to allocate from
+     * @param size Size of the buffer in bytes
+     * @note The buffer must outlive the arena and every allocation made from it
+     */
+    ArenaResource(void* buffer, size_type size) noexcept
+        : m_begin(static_cast<char*>(buffer)), m_size(size), m_offset(0) {}
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    /**
+     * @brief Allocate bytes with the given alignment
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the returned pointer, must be a power of two
+     * @return Pointer to the allocated memory, or nullptr if the arena is exhausted
+     *
+     * @note This function never throws. On failure, it asserts in debug builds and returns nullptr.
+     */
+    void* allocate(size_type bytes, size_type align = default_alignment) noexcept {
+        void* p = try_allocate(bytes, align);
+        assert(p != nullptr && "ArenaResource: buffer overflow");
+        return p;
+    }
+
+    /**
+     * @brief Allocate bytes with the given alignment, treating exhaustion as expected
+     *
+     * Same as allocate() without the debug assertion, for callers that fall back to
+     * other memory when the arena is full.
+     *
+     * @return Pointer to the allocated memory, or nullptr if the arena is exhausted
+     */
+    void* try_allocate(size_type bytes, size_type align = default_alignment) noexcept {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_begin);
+        const size_type start = stack_alloc_internal::align_up(base + m_offset, align) - base;
+
+        if (start > m_size || bytes > m_size - start) {
+            return nullptr;
+        }
+
+        m_offset = start + bytes;
+        return m_begin + start;
+    }
+
+    /**
+     * @brief Return memory to the arena
+     *
+     * Space is only reclaimed if p is the most recent allocation; otherwise it stays
+     * in use until reset().
+     *
+     * @param p Pointer returned by allocate()
+     * @param bytes Size passed to allocate()
+     */
+    void deallocate(void* p, size_type bytes, size_type = default_alignment) noexcept {
+        char* ptr = static_cast<char*>(p);
+        if (ptr + bytes == m_begin + m_offset) {
+            m_offset = static_cast<size_type>(ptr - m_begin);
+        }
+    }
+
+    /**
+     * @brief Record the current allocation offset
+     *
+     * @return Marker that can later be passed to rewind(); see RewindScope
+     */
+    size_type mark() const noexcept { return m_offset; }
+
+    /**
+     * @brief Release everything allocated since mark() in O(1)
+     *
+     * @param marker Value previously returned by mark()
+     * @warning Objects still living in the released region are not destroyed
+     */
+    void rewind(size_type marker) noexcept {
+        assert(marker <= m_offset && "ArenaResource: rewind past current offset");
+        m_offset = marker;
+    }
+
+    /**
+     * @brief Release every allocation at once
+     *
+     * @warning Objects still living in the arena are not destroyed; containers using it
+     *          must be gone (or hold only trivially destructible data) before reset()
+     */
+    void reset() noexcept { m_offset = 0; }
+
+    /** @brief Check whether p points into this arena's buffer */
+    bool owns(const void* p) const noexcept {
+        const char* ptr = static_cast<const char*>(p);
+        return ptr >= m_begin && ptr < m_begin + m_size;
+    }
+
+    /** @brief Get number of bytes in use (including alignment padding) */
+    size_type used() const noexcept { return m_offset; }
+    /** @brief Get total size of the buffer in bytes */
+    size_type capacity() const noexcept { return m_size; }
+    /** @brief Get number of bytes not yet handed out */
+    size_type remaining() const noexcept { return m_size - m_offset; }
+
+   private:
+    /// Start of the borrowed buffer
+    char* m_begin;
+    /// Size of the buffer in bytes
+    size_type m_size;
+    /// Current offset into the buffer for next allocation
+    size_type m_offset;
+};
+
+/**
+ * @brief Arena that holds its own N-byte buffer inline
+ *
+ * Declare one on the stack to give a whole per-request working set a single
+ * contiguous block that is freed when the arena goes out of scope.
+ *
+ * @tparam N The size of the buffer in bytes
+ */
+template <std::size_t N>
+class StackArena : public ArenaResource {
+   public:
+    /** @brief Construct an empty arena over the inline buffer */
+    StackArena() noexcept : ArenaResource(m_buffer, N) {}
+
+   private:
+    /// Inline buffer, aligned for any fundamental type
+    alignas(std::max_align_t) unsigned char m_buffer[N];
+};
+
+/**
+ * @brief Lightweight allocator handle that allocates from a shared arena
+ *
+ * Holds only a pointer to the arena, so it is cheap to copy and rebind. All copies and
+ * rebinds allocate from the same arena, which makes it usable with node-based containers
+ * such as std::list and std::map.
+ *
+ * @tparam T The type of objects to allocate
+ * @tparam Arena Arena type providing allocate(bytes, align) and deallocate(p, bytes, align)
+ *
+ * @note Allocation failures return nullptr (asserts in debug builds), as with StackAllocator
+ */
+template <typename T, typename Arena = ArenaResource>
+class ArenaAllocator {
+   public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = ArenaAllocator<U, Arena>;
+    };
+
+    /**
+     * @brief Create a handle to the given arena
+     * @param arena The arena to allocate from (must outlive the handle)
+     */
+    explicit ArenaAllocator(Arena& arena) noexcept : m_arena(&arena) {}
+
+    /**
+     * @brief Rebind copy constructor
+     *
+     * The new handle refers to the same arena.
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U, Arena>& other) noexcept : m_arena(other.arena()) {}
+
+    /**
+     * @brief Allocate memory for n objects of type T from the arena
+     * @return Pointer to allocated memory, or nullptr if the arena is exhausted
+     */
+    pointer allocate(size_type n) noexcept {
+        return static_cast<pointer>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /** @brief Return memory for n objects of type T to the arena */
+    void deallocate(pointer p, size_type n) noexcept {
+        m_arena->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    /** @brief Get the arena this handle allocates from */
+    Arena* arena() const noexcept { return m_arena; }
+
+    /** @brief Handles are equal if they share the same arena */
+    template <typename U>
+    bool operator==(const ArenaAllocator<U, Arena>& other) const noexcept {
+        return m_arena == other.arena();
+    }
+
+    /** @brief Handles are unequal if they use different arenas */
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U, Arena>& other) const noexcept {
+        return !(*this == other);
+    }
+
+   private:
+    /// The shared arena (never null)
+    Arena* m_arena;
+};
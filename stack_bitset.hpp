@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "bit_ops.hpp"
+#include "buffer_view.hpp"
+
+/**
+ * @brief Fixed-size bit set with inline 64-bit word storage
+ *
+ * Bits are packed 64 to a word, so set operations, counting and scanning work a whole
+ * word at a time: `a &= b` over 4096 flags is 64 AND instructions, count() is one
+ * hardware popcount per word, and iteration jumps straight to the next set bit with
+ * count-trailing-zeros. rank() and select() answer "how many flags before i" and "where
+ * is the k-th flag" without touching individual bits.
+ *
+ * Bits past N in the last word are kept zero by every operation.
+ *
+ * @tparam N Number of bits
+ *
+ * Example usage:
+ * @code
+ * StackBitset<4096> dirty, healthy;
+ * dirty.set(shard);
+ * StackBitset<4096> flush = dirty & healthy;
+ * flush.for_each_set([&](std::size_t i) { write_back(i); });
+ * dirty.reset();
+ * @endcode
+ *
+ * @note Index arguments are unchecked in release builds (assert in debug builds)
+ */
+template <std::size_t N>
+class StackBitset {
+    static_assert(N != 0, "StackBitset must hold at least one bit");
+
+   public:
+    using word_type = std::uint64_t;
+    using size_type = std::size_t;
+
+    /// Bits per storage word
+    static constexpr size_type word_bits = 64;
+    /// Number of storage words
+    static constexpr size_type word_count = (N + word_bits - 1) / word_bits;
+
+    /** @brief Construct with all bits clear */
+    StackBitset() noexcept : m_words{} {}
+
+    /** @brief Test bit i */
+    bool test(size_type i) const noexcept {
+        assert(i < N && "StackBitset: index out of range");
+        return (m_words[i / word_bits] >> (i % word_bits)) & 1u;
+    }
+    /** @brief Test bit i */
+    bool operator[](size_type i) const noexcept { return test(i); }
+
+    /** @brief Set bit i */
+    StackBitset& set(size_type i) noexcept {
+        assert(i < N && "StackBitset: index out of range");
+        m_words[i / word_bits] |= bit(i);
+        return *this;
+    }
+    /** @brief Set bit i to value */
+    StackBitset& set(size_type i, bool value) noexcept { return value ? set(i) : reset(i); }
+    /** @brief Clear bit i */
+    StackBitset& reset(size_type i) noexcept {
+        assert(i < N && "StackBitset: index out of range");
+        m_words[i / word_bits] &= ~bit(i);
+        return *this;
+    }
+    /** @brief Flip bit i */
+    StackBitset& flip(size_type i) noexcept {
+        assert(i < N && "StackBitset: index out of range");
+        m_words[i / word_bits] ^= bit(i);
+        return *this;
+    }
+
+    /** @brief Set all bits */
+    StackBitset& set() noexcept {
+        for (word_type& w : m_words) {
+            w = ~word_type{0};
+        }
+        trim();
+        return *this;
+    }
+    /** @brief Clear all bits */
+    StackBitset& reset() noexcept {
+        for (word_type& w : m_words) {
+            w = 0;
+        }
+        return *this;
+    }
+    /** @brief Flip all bits */
+    StackBitset& flip() noexcept {
+        for (word_type& w : m_words) {
+            w = ~w;
+        }
+        trim();
+        return *this;
+    }
+
+    /** @brief Keep only bits also set in other */
+    StackBitset& operator&=(const StackBitset& other) noexcept {
+        for (size_type i = 0; i < word_count; ++i) {
+            m_words[i] &= other.m_words[i];
+        }
+        return *this;
+    }
+    /** @brief Add bits set in other */
+    StackBitset& operator|=(const StackBitset& other) noexcept {
+        for (size_type i = 0; i < word_count; ++i) {
+            m_words[i] |= other.m_words[i];
+        }
+        return *this;
+    }
+    /** @brief Toggle bits set in other */
+    StackBitset& operator^=(const StackBitset& other) noexcept {
+        for (size_type i = 0; i < word_count; ++i) {
+            m_words[i] ^= other.m_words[i];
+        }
+        return *this;
+    }
+    /** @brief Clear bits set in other (this & ~other without a temporary) */
+    StackBitset& subtract(const StackBitset& other) noexcept {
+        for (size_type i = 0; i < word_count; ++i) {
+            m_words[i] &= ~other.m_words[i];
+        }
+        return *this;
+    }
+
+    /** @brief Get a copy with every bit flipped */
+    StackBitset operator~() const noexcept { return StackBitset(*this).flip(); }
+    /** @brief Intersection */
+    friend StackBitset operator&(StackBitset a, const StackBitset& b) noexcept { return a &= b; }
+    /** @brief Union */
+    friend StackBitset operator|(StackBitset a, const StackBitset& b) noexcept { return a |= b; }
+    /** @brief Symmetric difference */
+    friend StackBitset operator^(StackBitset a, const StackBitset& b) noexcept { return a ^= b; }
+
+    /** @brief Compare all bits */
+    friend bool operator==(const StackBitset& a, const StackBitset& b) noexcept {
+        for (size_type i = 0; i < word_count; ++i) {
+            if (a.m_words[i] != b.m_words[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /** @brief Compare all bits */
+    friend bool operator!=(const StackBitset& a, const StackBitset& b) noexcept {
+        return !(a == b);
+    }
+
+    /** @brief Count set bits */
+    size_type count() const noexcept {
+        size_type total = 0;
+        for (word_type w : m_words) {
+            total += bit_internal::popcount(w);
+        }
+        return total;
+    }
+    /** @brief Check whether any bit is set */
+    bool any() const noexcept {
+        for (word_type w : m_words) {
+            if (w != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /** @brief Check whether no bit is set */
+    bool none() const noexcept { return !any(); }
+    /** @brief Check whether every bit is set */
+    bool all() const noexcept { return count() == N; }
+
+    /**
+     * @brief Find the first set bit at or after pos
+     * @return Index of the bit, or N if there is none
+     */
+    size_type find_next(size_type pos) const noexcept {
+        if (pos >= N) {
+            return N;
+        }
+        size_type w = pos / word_bits;
+        word_type word = m_words[w] & (~word_type{0} << (pos % word_bits));
+        for (;;) {
+            if (word != 0) {
+                return w * word_bits + bit_internal::lowest_bit(word);
+            }
+            if (++w == word_count) {
+                return N;
+            }
+            word = m_words[w];
+        }
+    }
+    /** @brief Find the lowest set bit, or N if none */
+    size_type find_first() const noexcept { return find_next(0); }
+
+    /**
+     * @brief Call f(index) for every set bit in ascending order
+     *
+     * Visits whole zero words in one step and each set bit in one ctz, so the cost is
+     * proportional to word_count plus count().
+     *
+     * @param f Callable taking std::size_t
+     */
+    template <typename F>
+    void for_each_set(F&& f) const {
+        for (size_type w = 0; w < word_count; ++w) {
+            for (word_type word = m_words[w]; word != 0; word &= word - 1) {
+                f(w * word_bits + bit_internal::lowest_bit(word));
+            }
+        }
+    }
+
+    /**
+     * @brief Count set bits strictly before pos
+     * @param pos Bit position, 0 to N inclusive
+     */
+    size_type rank(size_type pos) const noexcept {
+        assert(pos <= N && "StackBitset: rank position out of range");
+        size_type total = 0;
+        const size_type full_words = pos / word_bits;
+        for (size_type w = 0; w < full_words; ++w) {
+            total += bit_internal::popcount(m_words[w]);
+        }
+        if (pos % word_bits != 0) {
+            total += bit_internal::popcount(m_words[full_words] & (bit(pos) - 1));
+        }
+        return total;
+    }
+
+    /**
+     * @brief Find the k-th set bit (counting from 0)
+     * @return Index of the bit, or N if fewer than k + 1 bits are set
+     */
+    size_type select(size_type k) const noexcept {
+        for (size_type w = 0; w < word_count; ++w) {
+            word_type word = m_words[w];
+            const size_type in_word = bit_internal::popcount(word);
+            if (k < in_word) {
+                for (; k != 0; --k) {
+                    word &= word - 1;
+                }
+                return w * word_bits + bit_internal::lowest_bit(word);
+            }
+            k -= in_word;
+        }
+        return N;
+    }
+
+    /** @brief Get the storage words (bit i is bit i % 64 of word i / 64) */
+    BufferView<const word_type> words() const noexcept { return {m_words, word_count}; }
+
+    /** @brief Get number of bits (always N) */
+    static constexpr std::size_t size() { return N; }
+
+   private:
+    static word_type bit(size_type i) noexcept { return word_type{1} << (i % word_bits); }
+
+    /// Clear the unused bits past N in the last word
+    void trim() noexcept {
+        if constexpr (N % word_bits != 0) {
+            m_words[word_count - 1] &= (word_type{1} << (N % word_bits)) - 1;
+        }
+    }
+
+    /// Bit storage, least significant bit first
+    word_type m_words[word_count];
+};
@@ -0,0 +1,37 @@
+#include <iostream>
+
+#include "stack_bitset.hpp"
+
+int main() {
+    // Example 1: Per-shard health and dirty flags combined word by word
+    std::cout << "Example 1: Flush dirty shards that are healthy\n";
+    constexpr std::size_t shards = 4096;
+    StackBitset<shards> healthy;
+    StackBitset<shards> dirty;
+    healthy.set();
+    healthy.reset(17).reset(2048);
+    for (std::size_t i = 0; i < shards; i += 511) {
+        dirty.set(i);
+    }
+    dirty.set(17);
+
+    const StackBitset<shards> flush = dirty & healthy;
+    std::cout << "dirty " << dirty.count() << ", healthy " << healthy.count() << ", flushing "
+              << flush.count() << ":";
+    flush.for_each_set([](std::size_t shard) { std::cout << " " << shard; });
+    std::cout << "\n";
+    dirty.subtract(flush);
+    std::cout << "still dirty (unhealthy): " << dirty.find_first() << "\n\n";
+
+    // Example 2: rank/select map between shard ids and dense positions
+    std::cout << "Example 2: Dense indexing with rank/select\n";
+    StackBitset<256> active;
+    for (std::size_t i : {3, 40, 41, 130, 255}) {
+        active.set(i);
+    }
+    std::cout << "shard 130 is active shard #" << active.rank(130) << "\n";
+    std::cout << "active shard #3 is shard " << active.select(3) << "\n";
+    std::cout << "first active at or after 42: " << active.find_next(42) << "\n";
+
+    return 0;
+}
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "bit_ops.hpp"
+#include "buffer_view.hpp"
+#include "stack_allocator.hpp"
+
+namespace flat_map_internal {
+
+/// Whether find_key() uses a vectorized compare for keys of type K
+template <typename K>
+constexpr bool simd_key_v =
+    std::is_integral<K>::value && !std::is_same<K, bool>::value &&
+    (sizeof(K) == 1 || sizeof(K) == 2 || sizeof(K) == 4 || sizeof(K) == 8);
+
+/**
+ * @brief Find the first index i < n with keys[i] == key, or n if absent
+ *
+ * For 1/2/4/8-byte integer keys this compares 16 bytes of keys per step with SSE2
+ * (64-bit lanes are built from two 32-bit compares); other keys use a scalar loop.
+ */
+template <typename K>
+std::size_t find_key(const K* keys, std::size_t n, const K& key) noexcept {
+    std::size_t i = 0;
+#ifdef STACK_VEC_SSE2
+    if constexpr (simd_key_v<K>) {
+        constexpr std::size_t lanes = 16 / sizeof(K);
+        __m128i needle;
+        if constexpr (sizeof(K) == 1) {
+            needle = _mm_set1_epi8(static_cast<char>(key));
+        } else if constexpr (sizeof(K) == 2) {
+            needle = _mm_set1_epi16(static_cast<short>(key));
+        } else if constexpr (sizeof(K) == 4) {
+            needle = _mm_set1_epi32(static_cast<int>(key));
+        } else {
+            needle = _mm_set1_epi64x(static_cast<long long>(key));
+        }
+        for (; i + lanes <= n; i += lanes) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+            __m128i eq;
+            if constexpr (sizeof(K) == 1) {
+                eq = _mm_cmpeq_epi8(block, needle);
+            } else if constexpr (sizeof(K) == 2) {
+                eq = _mm_cmpeq_epi16(block, needle);
+            } else if constexpr (sizeof(K) == 4) {
+                eq = _mm_cmpeq_epi32(block, needle);
+            } else {
+                const __m128i eq32 = _mm_cmpeq_epi32(block, needle);
+                eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+            if (mask != 0) {
+                return i + bit_internal::lowest_bit(mask) / sizeof(K);
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/// Whether a sorted container with this comparator can use find_key() for lookups
+template <typename K, typename Compare>
+constexpr bool use_key_scan_v =
+    simd_key_v<K> &&
+    (std::is_same<Compare, std::less<K>>::value || std::is_same<Compare, std::less<>>::value);
+
+}  // namespace flat_map_internal
+
+/**
+ * @brief Sorted fixed-capacity map with keys and values in separate inline arrays
+ *
+ * Keys and values are stored in two StackVectors, so a lookup only scans the dense key
+ * array. With integer keys and the default comparator, find() is a vectorized linear
+ * scan, which beats tree walks and hashing for the small tables (tens of entries) this
+ * container is meant for. Iteration visits keys in ascending order.
+ *
+ * @tparam K Key type
+ * @tparam V Mapped value type
+ * @tparam N Maximum number of entries
+ * @tparam Compare Strict weak ordering on keys (default: std::less<K>)
+ *
+ * Example usage:
+ * @code
+ * StackFlatMap<std::uint32_t, float, 64> weights;
+ * weights.insert(17, 0.5f);
+ * if (float* w = weights.find(17)) {
+ *     *w *= 2;
+ * }
+ * @endcode
+ *
+ * @note insert() returns {nullptr, false} when the map is full
+ */
+template <typename K, typename V, std::size_t N, typename Compare = std::less<K>>
+class StackFlatMap {
+   public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = std::size_t;
+
+    /** @brief Find the value for key, or nullptr if absent */
+    V* find(const K& key) noexcept {
+        const size_type idx = index_of(key);
+        return idx == size() ? nullptr : &m_values[idx];
+    }
+
+    /** @brief Find the value for key, or nullptr if absent (const) */
+    const V* find(const K& key) const noexcept {
+        const size_type idx = index_of(key);
+        return idx == size() ? nullptr : &m_values[idx];
+    }
+
+    /** @brief Check whether key is present */
+    bool contains(const K& key) const noexcept { return index_of(key) != size(); }
+
+    /**
+     * @brief Insert key with a value constructed from args, keeping keys sorted
+     *
+     * @return {pointer to the value, true} if inserted, {pointer to the existing value,
+     *         false} if key was already present, {nullptr, false} if the map is full
+     */
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+        const size_type idx = lower_bound_index(key);
+        if (idx != size() && !m_compare(key, m_keys[idx])) {
+            return {&m_values[idx], false};
+        }
+        if (full()) {
+            return {nullptr, false};
+        }
+        // Value first: if its constructor throws, neither array has changed
+        m_values.emplace(m_values.begin() + idx, std::forward<Args>(args)...);
+        try {
+            m_keys.emplace(m_keys.begin() + idx, key);
+        } catch (...) {
+            m_values.erase(m_values.begin() + idx);
+            throw;
+        }
+        return {&m_values[idx], true};
+    }
+
+    /** @brief Insert a copy of value under key; see try_emplace() */
+    std::pair<V*, bool> insert(const K& key, const V& value) { return try_emplace(key, value); }
+
+    /**
+     * @brief Access the value for key, inserting a value-initialized one if absent
+     * @note The map must not be full when key is absent (asserts in debug builds)
+     */
+    V& operator[](const K& key) {
+        V* value = try_emplace(key).first;
+        assert(value != nullptr && "StackFlatMap: capacity exceeded");
+        return *value;
+    }
+
+    /**
+     * @brief Remove key if present
+     * @return true if an entry was removed
+     */
+    bool erase(const K& key) {
+        const size_type idx = index_of(key);
+        if (idx == size()) {
+            return false;
+        }
+        // Values first: if V's move-assignment throws, the key array is still untouched
+        m_values.erase(m_values.begin() + idx);
+        m_keys.erase(m_keys.begin() + idx);
+        return true;
+    }
+
+    /** @brief Get the sorted keys */
+    BufferView<const K> keys() const noexcept { return {m_keys.data(), m_keys.size()}; }
+    /** @brief Get the values, in key order */
+    BufferView<V> values() noexcept { return {m_values.data(), m_values.size()}; }
+    /** @brief Get the values, in key order (const) */
+    BufferView<const V> values() const noexcept { return {m_values.data(), m_values.size()}; }
+
+    /** @brief Get the key at position idx (unchecked) */
+    const K& key_at(std::size_t idx) const noexcept { return m_keys[idx]; }
+    /** @brief Get the value at position idx (unchecked) */
+    V& value_at(std::size_t idx) noexcept { return m_values[idx]; }
+    /** @brief Get the value at position idx (unchecked, const) */
+    const V& value_at(std::size_t idx) const noexcept { return m_values[idx]; }
+
+    /** @brief Get number of entries */
+    std::size_t size() const noexcept { return m_keys.size(); }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_keys.empty(); }
+    /** @brief Check if no more entries fit */
+    bool full() const noexcept { return m_keys.full(); }
+    /** @brief Remove all entries */
+    void clear() noexcept {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+   private:
+    /// Position of the first key not less than key
+    size_type lower_bound_index(const K& key) const {
+        return static_cast<size_type>(
+            std::lower_bound(m_keys.begin(), m_keys.end(), key, m_compare) - m_keys.begin());
+    }
+
+    /// Position of key, or size() if absent
+    size_type index_of(const K& key) const noexcept {
+        if constexpr (flat_map_internal::use_key_scan_v<K, Compare>) {
+            return flat_map_internal::find_key(m_keys.data(), m_keys.size(), key);
+        } else {
+            const size_type idx = lower_bound_index(key);
+            return idx != size() && !m_compare(key, m_keys[idx]) ? idx : size();
+        }
+    }
+
+    /// Keys in ascending order
+    StackVector<K, N, true> m_keys;
+    /// Values, parallel to m_keys
+    StackVector<V, N, true> m_values;
+    /// Key ordering
+    Compare m_compare;
+};
+
+/**
+ * @brief Unsorted fixed-capacity map with keys and values in separate inline arrays
+ *
+ * Like StackFlatMap but entries are kept in no particular order, so insert is an append
+ * and erase moves the last entry into the hole. Lookups are a linear scan of the key
+ * array, vectorized for integer keys.
+ *
+ * @tparam K Key type (compared with ==)
+ * @tparam V Mapped value type
+ * @tparam N Maximum number of entries
+ *
+ * @note insert() returns {nullptr, false} when the map is full
+ * @note erase() changes the position of the last entry
+ */
+template <typename K, typename V, std::size_t N>
+class StackUnorderedFlatMap {
+   public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = std::size_t;
+
+    /** @brief Find the value for key, or nullptr if absent */
+    V* find(const K& key) noexcept {
+        const size_type idx = index_of(key);
+        return idx == size() ? nullptr : &m_values[idx];
+    }
+
+    /** @brief Find the value for key, or nullptr if absent (const) */
+    const V* find(const K& key) const noexcept {
+        const size_type idx = index_of(key);
+        return idx == size() ? nullptr : &m_values[idx];
+    }
+
+    /** @brief Check whether key is present */
+    bool contains(const K& key) const noexcept { return index_of(key) != size(); }
+
+    /**
+     * @brief Append key with a value constructed from args if key is absent
+     *
+     * @return {pointer to the value, true} if inserted, {pointer to the existing value,
+     *         false} if key was already present, {nullptr, false} if the map is full
+     */
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+        const size_type idx = index_of(key);
+        if (idx != size()) {
+            return {&m_values[idx], false};
+        }
+        if (full()) {
+            return {nullptr, false};
+        }
+        // Value first: if its constructor throws, neither array has changed
+        V& value = m_values.emplace_back(std::forward<Args>(args)...);
+        try {
+            m_keys.emplace_back(key);
+        } catch (...) {
+            m_values.pop_back();
+            throw;
+        }
+        return {&value, true};
+    }
+
+    /** @brief Insert a copy of value under key; see try_emplace() */
+    std::pair<V*, bool> insert(const K& key, const V& value) { return try_emplace(key, value); }
+
+    /**
+     * @brief Access the value for key, inserting a value-initialized one if absent
+     * @note The map must not be full when key is absent (asserts in debug builds)
+     */
+    V& operator[](const K& key) {
+        V* value = try_emplace(key).first;
+        assert(value != nullptr && "StackUnorderedFlatMap: capacity exceeded");
+        return *value;
+    }
+
+    /**
+     * @brief Remove key if present by moving the last entry into its slot
+     * @return true if an entry was removed
+     */
+    bool erase(const K& key) {
+        const size_type idx = index_of(key);
+        if (idx == size()) {
+            return false;
+        }
+        const size_type last = size() - 1;
+        if (idx != last) {
+            // Values first: if V's move-assignment throws, no key has been touched yet
+            m_values[idx] = std::move(m_values[last]);
+            m_keys[idx] = std::move(m_keys[last]);
+        }
+        m_values.pop_back();
+        m_keys.pop_back();
+        return true;
+    }
+
+    /** @brief Get the keys, in storage order */
+    BufferView<const K> keys() const noexcept { return {m_keys.data(), m_keys.size()}; }
+    /** @brief Get the values, in storage order */
+    BufferView<V> values() noexcept { return {m_values.data(), m_values.size()}; }
+    /** @brief Get the values, in storage order (const) */
+    BufferView<const V> values() const noexcept { return {m_values.data(), m_values.size()}; }
+
+    /** @brief Get the key at position idx (unchecked) */
+    const K& key_at(std::size_t idx) const noexcept { return m_keys[idx]; }
+    /** @brief Get the value at position idx (unchecked) */
+    V& value_at(std::size_t idx) noexcept { return m_values[idx]; }
+    /** @brief Get the value at position idx (unchecked, const) */
+    const V& value_at(std::size_t idx) const noexcept { return m_values[idx]; }
+
+    /** @brief Get number of entries */
+    std::size_t size() const noexcept { return m_keys.size(); }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_keys.empty(); }
+    /** @brief Check if no more entries fit */
+    bool full() const noexcept { return m_keys.full(); }
+    /** @brief Remove all entries */
+    void clear() noexcept {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+   private:
+    /// Position of key, or size() if absent
+    size_type index_of(const K& key) const noexcept {
+        return flat_map_internal::find_key(m_keys.data(), m_keys.size(), key);
+    }
+
+    /// Keys in insertion order (modulo erase)
+    StackVector<K, N, true> m_keys;
+    /// Values, parallel to m_keys
+    StackVector<V, N, true> m_values;
+};
+
+/**
+ * @brief Sorted fixed-capacity set on inline storage
+ *
+ * The set counterpart of StackFlatMap: one sorted key array, vectorized lookups for
+ * integer keys with the default comparator.
+ *
+ * @tparam K Key type
+ * @tparam N Maximum number of keys
+ * @tparam Compare Strict weak ordering on keys (default: std::less<K>)
+ */
+template <typename K, std::size_t N, typename Compare = std::less<K>>
+class StackFlatSet {
+   public:
+    using key_type = K;
+    using value_type = K;
+    using size_type = std::size_t;
+    using const_iterator = const K*;
+
+    /** @brief Check whether key is present */
+    bool contains(const K& key) const noexcept {
+        if constexpr (flat_map_internal::use_key_scan_v<K, Compare>) {
+            return flat_map_internal::find_key(m_keys.data(), m_keys.size(), key) != size();
+        } else {
+            const size_type idx = lower_bound_index(key);
+            return idx != size() && !m_compare(key, m_keys[idx]);
+        }
+    }
+
+    /**
+     * @brief Insert key, keeping keys sorted
+     * @return true if inserted, false if already present or the set is full
+     */
+    bool insert(const K& key) {
+        const size_type idx = lower_bound_index(key);
+        if ((idx != size() && !m_compare(key, m_keys[idx])) || full()) {
+            return false;
+        }
+        m_keys.insert(m_keys.begin() + idx, key);
+        return true;
+    }
+
+    /**
+     * @brief Remove key if present
+     * @return true if a key was removed
+     */
+    bool erase(const K& key) {
+        const size_type idx = lower_bound_index(key);
+        if (idx == size() || m_compare(key, m_keys[idx])) {
+            return false;
+        }
+        m_keys.erase(m_keys.begin() + idx);
+        return true;
+    }
+
+    /** @brief Get const iterator to the smallest key */
+    const_iterator begin() const noexcept { return m_keys.begin(); }
+    /** @brief Get const iterator past the largest key */
+    const_iterator end() const noexcept { return m_keys.end(); }
+    /** @brief Get the sorted keys */
+    BufferView<const K> keys() const noexcept { return {m_keys.data(), m_keys.size()}; }
+
+    /** @brief Get number of keys */
+    std::size_t size() const noexcept { return m_keys.size(); }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_keys.empty(); }
+    /** @brief Check if no more keys fit */
+    bool full() const noexcept { return m_keys.full(); }
+    /** @brief Remove all keys */
+    void clear() noexcept { m_keys.clear(); }
+
+   private:
+    /// Position of the first key not less than key
+    size_type lower_bound_index(const K& key) const {
+        return static_cast<size_type>(
+            std::lower_bound(m_keys.begin(), m_keys.end(), key, m_compare) - m_keys.begin());
+    }
+
+    /// Keys in ascending order
+    StackVector<K, N, true> m_keys;
+    /// Key ordering
+    Compare m_compare;
+};
+
+/**
+ * @brief Unsorted fixed-capacity set on inline storage
+ *
+ * Insert is an append and erase moves the last key into the hole; lookups are a
+ * linear scan, vectorized for integer keys.
+ *
+ * @tparam K Key type (compared with ==)
+ * @tparam N Maximum number of keys
+ */
+template <typename K, std::size_t N>
+class StackUnorderedFlatSet {
+   public:
+    using key_type = K;
+    using value_type = K;
+    using size_type = std::size_t;
+    using const_iterator = const K*;
+
+    /** @brief Check whether key is present */
+    bool contains(const K& key) const noexcept {
+        return flat_map_internal::find_key(m_keys.data(), m_keys.size(), key) != size();
+    }
+
+    /**
+     * @brief Append key if absent
+     * @return true if inserted, false if already present or the set is full
+     */
+    bool insert(const K& key) {
+        if (contains(key) || full()) {
+            return false;
+        }
+        m_keys.push_back(key);
+        return true;
+    }
+
+    /**
+     * @brief Remove key if present by moving the last key into its slot
+     * @return true if a key was removed
+     */
+    bool erase(const K& key) {
+        const size_type idx = flat_map_internal::find_key(m_keys.data(), m_keys.size(), key);
+        if (idx == size()) {
+            return false;
+        }
+        if (idx != size() - 1) {
+            m_keys[idx] = std::move(m_keys.back());
+        }
+        m_keys.pop_back();
+        return true;
+    }
+
+    /** @brief Get const iterator to the first key */
+    const_iterator begin() const noexcept { return m_keys.begin(); }
+    /** @brief Get const iterator past the last key */
+    const_iterator end() const noexcept { return m_keys.end(); }
+    /** @brief Get the keys, in storage order */
+    BufferView<const K> keys() const noexcept { return {m_keys.data(), m_keys.size()}; }
+
+    /** @brief Get number of keys */
+    std::size_t size() const noexcept { return m_keys.size(); }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_keys.empty(); }
+    /** @brief Check if no more keys fit */
+    bool full() const noexcept { return m_keys.full(); }
+    /** @brief Remove all keys */
+    void clear() noexcept { m_keys.clear(); }
+
+   private:
+    /// Keys in insertion order (modulo erase)
+    StackVector<K, N, true> m_keys;
+};
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "bit_ops.hpp"
+#include "stack_allocator.hpp"
+
+namespace hash_map_internal {
+
+/// Control byte of a slot that has never held an entry
+constexpr signed char ctrl_empty = -128;  // 0b10000000
+/// Control byte of a slot whose entry was erased (tombstone)
+constexpr signed char ctrl_deleted = -2;  // 0b11111110
+/// Slots probed together; one SSE2 register of control bytes
+constexpr std::size_t group_width = 16;
+
+/// Smallest power-of-two slot count (at least one group) keeping load at or below 7/8
+constexpr std::size_t table_slots(std::size_t capacity) noexcept {
+    std::size_t slots = group_width;
+    while (slots - slots / 8 < capacity) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+/// Spread the bits of a user hash; std::hash is the identity for integers on common
+/// standard libraries, which would leave H1 and H2 correlated
+inline std::size_t mix(std::size_t h) noexcept {
+    if constexpr (sizeof(std::size_t) == 8) {
+        h *= static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+        return h ^ (h >> 32);
+    } else {
+        h *= static_cast<std::size_t>(0x9E3779B9u);
+        return h ^ (h >> 16);
+    }
+}
+
+/**
+ * @brief One group of 16 control bytes
+ *
+ * Each match returns a bit mask with bit i set when byte i qualifies. With SSE2 a match
+ * is one compare and one movemask; otherwise the bytes are tested one by one.
+ */
+struct Group {
+    const signed char* ctrl;
+
+    /// Slots whose control byte equals h2 (candidate entries)
+    unsigned match(signed char h2) const noexcept {
+#ifdef STACK_VEC_SSE2
+        const __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+#else
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < group_width; ++i) {
+            mask |= static_cast<unsigned>(ctrl[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /// Slots that have never been used; a probe for an absent key stops at these
+    unsigned match_empty() const noexcept { return match(ctrl_empty); }
+
+    /// Slots that do not hold an entry (empty or tombstone)
+    unsigned match_free() const noexcept {
+#ifdef STACK_VEC_SSE2
+        const __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<unsigned>(_mm_movemask_epi8(bytes));
+#else
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < group_width; ++i) {
+            mask |= static_cast<unsigned>(ctrl[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+};
+
+}  // namespace hash_map_internal
+
+/**
+ * @brief Fixed-capacity open-addressing hash map with the whole table inline
+ *
+ * A Swiss-table layout: one control byte per slot holds 7 bits of the key's hash (H2)
+ * or an empty/tombstone marker, and slots are probed in groups of 16 whose control
+ * bytes are compared against H2 with a single SSE2 instruction. The rest of the hash
+ * (H1) picks the first group; further groups follow a triangular sequence that visits
+ * every group once. Keys and values live in separate inline arrays next to the control
+ * bytes, so the map never allocates and never rehashes.
+ *
+ * The table is sized at compile time to the smallest power of two that keeps the load
+ * factor at or below 7/8 for Capacity entries, so a typical lookup touches one group.
+ *
+ * @tparam K Key type
+ * @tparam V Mapped value type
+ * @tparam Capacity Maximum number of entries
+ * @tparam Hash Hash function object (default: std::hash<K>)
+ * @tparam KeyEqual Key equality (default: std::equal_to<K>)
+ *
+ * Example usage:
+ * @code
+ * StackHashMap<std::uint64_t, Row*, 256> seen;
+ * for (Row& row : rows) {
+ *     if (!seen.try_emplace(row.id, &row).second) {
+ *         // duplicate id
+ *     }
+ * }
+ * @endcode
+ *
+ * @note try_emplace() returns {nullptr, false} once Capacity entries are stored
+ * @note erase() leaves a tombstone only when the slot's group has no empty slot, so
+ *       probe sequences for absent keys stay short under churn
+ * @note Not copyable or movable
+ */
+template <typename K, typename V, std::size_t Capacity, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class StackHashMap {
+    static_assert(Capacity != 0, "StackHashMap capacity must be non-zero");
+
+   public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    /// Number of slots in the table (a power of two, at least 16)
+    static constexpr size_type slot_count = hash_map_internal::table_slots(Capacity);
+
+    /** @brief Construct an empty map */
+    StackHashMap() noexcept : m_size(0) { reset_ctrl(); }
+
+    StackHashMap(const StackHashMap&) = delete;
+    StackHashMap& operator=(const StackHashMap&) = delete;
+
+    /// Destroys all entries
+    ~StackHashMap() { destroy_all(); }
+
+    /** @brief Find the value for key, or nullptr if absent */
+    V* find(const K& key) noexcept {
+        const size_type idx = find_index(key, hash_of(key));
+        return idx == npos ? nullptr : value_slot(idx);
+    }
+
+    /** @brief Find the value for key, or nullptr if absent (const) */
+    const V* find(const K& key) const noexcept {
+        const size_type idx = find_index(key, hash_of(key));
+        return idx == npos ? nullptr : value_slot(idx);
+    }
+
+    /** @brief Check whether key is present */
+    bool contains(const K& key) const noexcept { return find(key) != nullptr; }
+
+    /**
+     * @brief Insert key with a value constructed from args
+     *
+     * @return {pointer to the value, true} if inserted, {pointer to the existing value,
+     *         false} if key was already present, {nullptr, false} if the map is full
+     */
+    template <typename... Args>
+    std::pair<V*, bool> try_emplace(const K& key, Args&&... args) {
+        const std::size_t hash = hash_of(key);
+        const size_type existing = find_index(key, hash);
+        if (existing != npos) {
+            return {value_slot(existing), false};
+        }
+        if (full()) {
+            return {nullptr, false};
+        }
+        const size_type idx = find_free(hash);
+        ::new (static_cast<void*>(key_slot(idx))) K(key);
+        try {
+            ::new (static_cast<void*>(value_slot(idx))) V(std::forward<Args>(args)...);
+        } catch (...) {
+            stack_alloc_internal::destroy_n(key_slot(idx), 1);
+            throw;
+        }
+        m_ctrl[idx] = h2(hash);
+        ++m_size;
+        return {value_slot(idx), true};
+    }
+
+    /** @brief Insert a copy of value under key; see try_emplace() */
+    std::pair<V*, bool> insert(const K& key, const V& value) { return try_emplace(key, value); }
+
+    /**
+     * @brief Access the value for key, inserting a value-initialized one if absent
+     * @note The map must not be full when key is absent (asserts in debug builds)
+     */
+    V& operator[](const K& key) {
+        V* value = try_emplace(key).first;
+        assert(value != nullptr && "StackHashMap: capacity exceeded");
+        return *value;
+    }
+
+    /**
+     * @brief Remove key if present
+     * @return true if an entry was removed
+     */
+    bool erase(const K& key) noexcept {
+        const size_type idx = find_index(key, hash_of(key));
+        if (idx == npos) {
+            return false;
+        }
+        stack_alloc_internal::destroy_n(key_slot(idx), 1);
+        stack_alloc_internal::destroy_n(value_slot(idx), 1);
+        // A probe that reached this group would also have seen its empty slot and stopped,
+        // so the slot can become empty again instead of a tombstone
+        const hash_map_internal::Group group{m_ctrl + (idx & ~(group_width - 1))};
+        m_ctrl[idx] = group.match_empty() != 0 ? hash_map_internal::ctrl_empty
+                                               : hash_map_internal::ctrl_deleted;
+        --m_size;
+        return true;
+    }
+
+    /**
+     * @brief Call f(key, value) for every entry, in table order
+     * @param f Callable taking (const K&, V&)
+     */
+    template <typename F>
+    void for_each(F&& f) {
+        for (size_type i = 0; i < slot_count; ++i) {
+            if (m_ctrl[i] >= 0) {
+                f(static_cast<const K&>(*key_slot(i)), *value_slot(i));
+            }
+        }
+    }
+
+    /**
+     * @brief Call f(key, value) for every entry, in table order (const)
+     * @param f Callable taking (const K&, const V&)
+     */
+    template <typename F>
+    void for_each(F&& f) const {
+        for (size_type i = 0; i < slot_count; ++i) {
+            if (m_ctrl[i] >= 0) {
+                f(*key_slot(i), *value_slot(i));
+            }
+        }
+    }
+
+    /** @brief Get number of entries */
+    std::size_t size() const noexcept { return m_size; }
+    /** @brief Get capacity (always Capacity) */
+    static constexpr std::size_t capacity() { return Capacity; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_size == 0; }
+    /** @brief Check if no more entries fit */
+    bool full() const noexcept { return m_size == Capacity; }
+    /** @brief Remove all entries (also clears tombstones) */
+    void clear() noexcept {
+        destroy_all();
+        reset_ctrl();
+        m_size = 0;
+    }
+
+   private:
+    static constexpr size_type group_width = hash_map_internal::group_width;
+    static constexpr size_type group_count = slot_count / group_width;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    std::size_t hash_of(const K& key) const noexcept {
+        return hash_map_internal::mix(m_hash(key));
+    }
+    /// Low 7 bits of the hash, stored in the control byte
+    static signed char h2(std::size_t hash) noexcept {
+        return static_cast<signed char>(hash & 0x7F);
+    }
+    /// Remaining bits of the hash, selecting the first group
+    static size_type first_group(std::size_t hash) noexcept {
+        return (hash >> 7) & (group_count - 1);
+    }
+
+    /// Slot index of key, or npos if absent
+    size_type find_index(const K& key, std::size_t hash) const noexcept {
+        const signed char tag = h2(hash);
+        size_type group = first_group(hash);
+        for (size_type probe = 0; probe < group_count; ++probe) {
+            const size_type base = group * group_width;
+            const hash_map_internal::Group ctrl{m_ctrl + base};
+            for (unsigned mask = ctrl.match(tag); mask != 0; mask &= mask - 1) {
+                const size_type idx = base + bit_internal::lowest_bit(mask);
+                if (m_equal(*key_slot(idx), key)) {
+                    return idx;
+                }
+            }
+            if (ctrl.match_empty() != 0) {
+                return npos;
+            }
+            group = (group + probe + 1) & (group_count - 1);
+        }
+        return npos;
+    }
+
+    /// First empty or tombstone slot on the probe sequence of hash (the map is not full)
+    size_type find_free(std::size_t hash) const noexcept {
+        size_type group = first_group(hash);
+        for (size_type probe = 0;; ++probe) {
+            const size_type base = group * group_width;
+            const unsigned mask = hash_map_internal::Group{m_ctrl + base}.match_free();
+            if (mask != 0) {
+                return base + bit_internal::lowest_bit(mask);
+            }
+            group = (group + probe + 1) & (group_count - 1);
+        }
+    }
+
+    K* key_slot(size_type idx) noexcept { return reinterpret_cast<K*>(m_keys) + idx; }
+    const K* key_slot(size_type idx) const noexcept {
+        return reinterpret_cast<const K*>(m_keys) + idx;
+    }
+    V* value_slot(size_type idx) noexcept { return reinterpret_cast<V*>(m_values) + idx; }
+    const V* value_slot(size_type idx) const noexcept {
+        return reinterpret_cast<const V*>(m_values) + idx;
+    }
+
+    void reset_ctrl() noexcept {
+        for (size_type i = 0; i < slot_count; ++i) {
+            m_ctrl[i] = hash_map_internal::ctrl_empty;
+        }
+    }
+
+    void destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible<K>::value ||
+                      !std::is_trivially_destructible<V>::value) {
+            for (size_type i = 0; i < slot_count; ++i) {
+                if (m_ctrl[i] >= 0) {
+                    stack_alloc_internal::destroy_n(key_slot(i), 1);
+                    stack_alloc_internal::destroy_n(value_slot(i), 1);
+                }
+            }
+        }
+    }
+
+    /// One control byte per slot: H2 of the entry, ctrl_empty or ctrl_deleted
+    alignas(group_width) signed char m_ctrl[slot_count];
+    /// Inline key storage, indexed like m_ctrl
+    alignas(K) unsigned char m_keys[slot_count * sizeof(K)];
+    /// Inline value storage, indexed like m_ctrl
+    alignas(V) unsigned char m_values[slot_count * sizeof(V)];
+    /// Number of entries
+    size_type m_size;
+    /// Key hasher
+    Hash m_hash;
+    /// Key equality
+    KeyEqual m_equal;
+};
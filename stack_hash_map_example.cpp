@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "stack_hash_map.hpp"
+
+struct Order {
+    std::uint64_t id;
+    int customer;
+    double amount;
+};
+
+int main() {
+    // Example 1: Dedup of request ids
+    std::cout << "Example 1: Dedup\n";
+    const std::uint64_t ids[] = {42, 7, 42, 1001, 7, 8};
+    StackHashMap<std::uint64_t, int, 256> seen;
+    for (std::uint64_t id : ids) {
+        auto [count, inserted] = seen.try_emplace(id, 0);
+        ++*count;
+        if (!inserted) {
+            std::cout << "duplicate id " << id << " (seen " << *count << " times)\n";
+        }
+    }
+    std::cout << seen.size() << " unique ids, table has " << seen.slot_count << " slots\n\n";
+
+    // Example 2: Hash join of orders against a small customer table
+    std::cout << "Example 2: Hash join\n";
+    StackHashMap<int, std::string_view, 64> customers;
+    customers.insert(1, "acme");
+    customers.insert(2, "globex");
+    customers.insert(3, "initech");
+    const Order orders[] = {{1, 2, 10.5}, {2, 3, 99.0}, {3, 9, 5.0}, {4, 2, 1.25}};
+    for (const Order& order : orders) {
+        if (const std::string_view* name = customers.find(order.customer)) {
+            std::cout << "order " << order.id << " -> " << *name << " " << order.amount << "\n";
+        } else {
+            std::cout << "order " << order.id << " -> unknown customer " << order.customer
+                      << "\n";
+        }
+    }
+    std::cout << "\n";
+
+    // Example 3: Counting with operator[], erase and iteration
+    std::cout << "Example 3: Word counts\n";
+    StackHashMap<std::string, int, 32> counts;
+    for (const char* word : {"a", "b", "a", "c", "b", "a"}) {
+        ++counts[word];
+    }
+    counts.erase("c");
+    counts.for_each([](const std::string& word, int n) { std::cout << word << "=" << n << " "; });
+    std::cout << "\n";
+
+    // Example 4: No growth; inserts fail once Capacity entries are stored
+    std::cout << "\nExample 4: Fixed capacity\n";
+    StackHashMap<int, int, 4> tiny;
+    for (int i = 0; i < 6; ++i) {
+        std::cout << "insert " << i << ": " << (tiny.insert(i, i).first ? "ok" : "full") << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "stack_arena.hpp"
+
+/**
+ * @brief std::pmr::memory_resource that bump-allocates from a borrowed buffer
+ *
+ * Wraps the ArenaResource bump logic in the polymorphic interface, so
+ * std::pmr::vector, std::pmr::string, std::pmr::unordered_map and any other pmr
+ * container can share one fixed buffer without their types depending on it. Requests
+ * that no longer fit go to an upstream resource.
+ *
+ * Example usage:
+ * @code
+ * alignas(std::max_align_t) char buffer[16 * 1024];
+ * ArenaMemoryResource arena{buffer, sizeof(buffer), std::pmr::new_delete_resource()};
+ *
+ * std::pmr::vector<int> ids{&arena};
+ * std::pmr::unordered_map<int, std::pmr::string> names{&arena};  // strings use it too
+ * @endcode
+ *
+ * @note Like ArenaResource, only the most recent buffer allocation is reclaimed by
+ *       deallocation; everything else is released by reset() or with the buffer.
+ *       Upstream allocations are returned to the upstream one by one.
+ * @note With the default upstream (std::pmr::null_memory_resource()) an exhausted
+ *       buffer throws std::bad_alloc, as the memory_resource contract requires a
+ *       resource to either return memory or throw
+ * @note Not copyable or movable: containers refer to the resource by address
+ */
+class ArenaMemoryResource : public std::pmr::memory_resource {
+   public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Construct a resource over an existing buffer
+     *
+     * @param buffer Start of the buffer to allocate from
+     * @param size Size of the buffer in bytes
+     * @param upstream Resource used once the buffer is exhausted (default: none)
+     * @note The buffer and upstream must outlive the resource and every allocation
+     */
+    ArenaMemoryResource(
+        void* buffer, size_type size,
+        std::pmr::memory_resource* upstream = std::pmr::null_memory_resource()) noexcept
+        : m_arena(buffer, size), m_upstream(upstream), m_upstream_allocations(0) {}
+
+    ArenaMemoryResource(const ArenaMemoryResource&) = delete;
+    ArenaMemoryResource& operator=(const ArenaMemoryResource&) = delete;
+
+    /**
+     * @brief Release every buffer allocation at once
+     *
+     * @warning Objects still living in the buffer are not destroyed; containers using
+     *          it must be gone first. Upstream allocations are unaffected.
+     */
+    void reset() noexcept { m_arena.reset(); }
+
+    /** @brief Record the current buffer offset; see RewindScope */
+    size_type mark() const noexcept { return m_arena.mark(); }
+    /** @brief Release every buffer allocation made since mark() */
+    void rewind(size_type marker) noexcept { m_arena.rewind(marker); }
+
+    /** @brief Get the resource that serves requests once the buffer is full */
+    std::pmr::memory_resource* upstream() const noexcept { return m_upstream; }
+    /** @brief Get number of allocations that went to the upstream resource */
+    size_type upstream_allocations() const noexcept { return m_upstream_allocations; }
+
+    /** @brief Get number of buffer bytes in use (including alignment padding) */
+    size_type used() const noexcept { return m_arena.used(); }
+    /** @brief Get total size of the buffer in bytes */
+    size_type capacity() const noexcept { return m_arena.capacity(); }
+    /** @brief Get number of buffer bytes not yet handed out */
+    size_type remaining() const noexcept { return m_arena.remaining(); }
+
+   protected:
+    // Zero-byte requests are served as one byte, so a full buffer never hands out its
+    // one-past-end pointer, which owns() would then route to the upstream resource
+    void* do_allocate(size_type bytes, size_type align) override {
+        bytes = bytes == 0 ? 1 : bytes;
+        if (void* p = m_arena.try_allocate(bytes, align)) {
+            return p;
+        }
+        ++m_upstream_allocations;
+        return m_upstream->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_type bytes, size_type align) override {
+        bytes = bytes == 0 ? 1 : bytes;
+        if (m_arena.owns(p)) {
+            m_arena.deallocate(p, bytes, align);
+        } else {
+            m_upstream->deallocate(p, bytes, align);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   private:
+    /// Bump state over the borrowed buffer
+    ArenaResource m_arena;
+    /// Fallback for requests that do not fit
+    std::pmr::memory_resource* m_upstream;
+    /// Number of requests the buffer could not serve
+    size_type m_upstream_allocations;
+};
+
+/**
+ * @brief ArenaMemoryResource that holds its own N-byte buffer inline
+ *
+ * Declare one on the stack to back a request's pmr containers with a single block
+ * that is freed when the resource goes out of scope.
+ *
+ * @tparam N The size of the buffer in bytes
+ */
+template <std::size_t N>
+class StackMemoryResource : public ArenaMemoryResource {
+   public:
+    /**
+     * @brief Construct an empty resource over the inline buffer
+     *
+     * @param upstream Resource used once the buffer is exhausted (default: none)
+     */
+    explicit StackMemoryResource(
+        std::pmr::memory_resource* upstream = std::pmr::null_memory_resource()) noexcept
+        : ArenaMemoryResource(m_buffer, N, upstream) {}
+
+   private:
+    /// Inline buffer, aligned for any fundamental type
+    alignas(std::max_align_t) unsigned char m_buffer[N];
+};
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "stack_memory_resource.hpp"
+
+// An API that takes pmr containers; it does not know where their memory comes from
+static std::size_t count_words(const std::pmr::vector<std::pmr::string>& words,
+                               std::pmr::unordered_map<std::pmr::string, int>& counts) {
+    for (const auto& word : words) {
+        ++counts[word];
+    }
+    return counts.size();
+}
+
+int main() {
+    // Example 1: Several pmr containers sharing one stack buffer
+    std::cout << "Example 1: pmr containers on a StackMemoryResource\n";
+    {
+        StackMemoryResource<16 * 1024> scratch;
+        std::pmr::vector<std::pmr::string> words{&scratch};
+        for (const char* w : {"stack", "heap", "stack", "arena", "a long word that skips SSO",
+                              "stack"}) {
+            words.emplace_back(w);  // the strings allocate from scratch too
+        }
+        std::pmr::unordered_map<std::pmr::string, int> counts{&scratch};
+        const std::size_t distinct = count_words(words, counts);
+        std::cout << distinct << " distinct words, \"stack\" x" << counts["stack"] << ", "
+                  << scratch.used() << " of " << scratch.capacity() << " bytes used\n\n";
+    }
+
+    // Example 2: Spilling to the heap once the buffer is full
+    std::cout << "Example 2: Overflow to an upstream resource\n";
+    {
+        StackMemoryResource<1024> small{std::pmr::new_delete_resource()};
+        std::pmr::vector<int> values{&small};
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        std::cout << values.size() << " values, " << small.upstream_allocations()
+                  << " growth steps served by the heap\n\n";
+    }
+
+    // Example 3: Without an upstream, exhaustion throws as the pmr contract requires
+    std::cout << "Example 3: No upstream\n";
+    {
+        alignas(std::max_align_t) char buffer[256];
+        ArenaMemoryResource strict{buffer, sizeof(buffer)};
+        std::pmr::vector<char> bytes{&strict};
+        try {
+            bytes.reserve(1024);
+        } catch (const std::bad_alloc&) {
+            std::cout << "reserve(1024) raised std::bad_alloc\n";
+        }
+    }
+
+    // Example 4: A zero-byte request on a full buffer still round-trips
+    std::cout << "\nExample 4: Zero-byte request on a full buffer\n";
+    {
+        alignas(std::max_align_t) char buffer[64];
+        ArenaMemoryResource full{buffer, sizeof(buffer), std::pmr::new_delete_resource()};
+        void* block = full.allocate(64, 1);
+        void* empty = full.allocate(0, 1);
+        std::cout << "zero-byte block served by "
+                  << (full.upstream_allocations() != 0 ? "upstream" : "buffer") << "\n";
+        full.deallocate(empty, 0, 1);
+        full.deallocate(block, 64, 1);
+        std::cout << full.used() << " bytes used after both are returned\n";
+    }
+
+    return 0;
+}
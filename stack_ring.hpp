@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "buffer_view.hpp"
+#include "stack_allocator.hpp"
+
+/**
+ * @brief Fixed-capacity double-ended ring buffer with inline storage
+ *
+ * Elements live directly in the object. Head and tail are free-running counters that
+ * are reduced to slot indices with a power-of-two mask, so every push and pop is a
+ * few instructions and never allocates. Readable (and, for trivially copyable T,
+ * writable) regions are exposed as at most two BufferView segments so consumers can
+ * process data in place across the wrap point.
+ *
+ * @tparam T The type of elements in the ring
+ * @tparam N The maximum number of elements (must be a power of two)
+ *
+ * Example usage:
+ * @code
+ * StackRing<char, 4096> window;
+ * auto [first, second] = window.free_segments();
+ * std::size_t got = read_socket(first);   // fill in place
+ * window.commit_back(got);
+ *
+ * auto [a, b] = window.segments();
+ * std::size_t used = parse(a, b);         // no copy across the wrap
+ * window.consume_front(used);
+ * @endcode
+ *
+ * @note This class is not copyable; moves relocate elements
+ * @note Single pushes past capacity assert in debug builds; bulk pushes stop when full
+ */
+template <typename T, std::size_t N>
+class StackRing {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "StackRing capacity must be a power of two");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    /** @brief Construct an empty ring */
+    StackRing() noexcept : m_head(0), m_tail(0) {}
+
+    StackRing(const StackRing&) = delete;
+    StackRing& operator=(const StackRing&) = delete;
+
+    /**
+     * @brief Move constructor
+     *
+     * Relocates other's elements to the front of this ring and leaves other empty.
+     */
+    StackRing(StackRing&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : m_head(0), m_tail(0) {
+        take(other);
+    }
+
+    /** @brief Move assignment; see the move constructor */
+    StackRing& operator=(StackRing&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+
+    /// Destroys all elements
+    ~StackRing() { clear(); }
+
+    /** @brief Add element to the back (copy) */
+    void push_back(const T& value) { emplace_back(value); }
+    /** @brief Add element to the back (move) */
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    /** @brief Add element to the front (copy) */
+    void push_front(const T& value) { emplace_front(value); }
+    /** @brief Add element to the front (move) */
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    /**
+     * @brief Construct element in-place at the back
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        assert(!full() && "StackRing: capacity exceeded");
+        T* elem = ::new (static_cast<void*>(slot(m_tail))) T(std::forward<Args>(args)...);
+        ++m_tail;
+        return *elem;
+    }
+
+    /**
+     * @brief Construct element in-place at the front
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        assert(!full() && "StackRing: capacity exceeded");
+        T* elem = ::new (static_cast<void*>(slot(m_head - 1))) T(std::forward<Args>(args)...);
+        --m_head;
+        return *elem;
+    }
+
+    /** @brief Remove the front element (must not be empty) */
+    void pop_front() noexcept {
+        assert(!empty() && "StackRing: pop_front on empty ring");
+        stack_alloc_internal::destroy_n(slot(m_head), 1);
+        ++m_head;
+    }
+
+    /** @brief Remove the back element (must not be empty) */
+    void pop_back() noexcept {
+        assert(!empty() && "StackRing: pop_back on empty ring");
+        --m_tail;
+        stack_alloc_internal::destroy_n(slot(m_tail), 1);
+    }
+
+    /**
+     * @brief Append up to count elements from src
+     *
+     * Copies in at most two contiguous pieces (memcpy for trivially copyable types).
+     * If a copy throws, the elements already copied are destroyed and the ring is
+     * unchanged.
+     *
+     * @return Number of elements appended (less than count if the ring filled up)
+     */
+    size_type push_back_n(const T* src, size_type count) {
+        const size_type n = count < N - size() ? count : N - size();
+        const size_type first = contiguous_from(m_tail, n);
+        stack_alloc_internal::copy_n(slot(m_tail), src, first);
+        try {
+            stack_alloc_internal::copy_n(slot(m_tail + first), src + first, n - first);
+        } catch (...) {
+            stack_alloc_internal::destroy_n(slot(m_tail), first);
+            throw;
+        }
+        m_tail += n;
+        return n;
+    }
+
+    /**
+     * @brief Move up to count elements from the front into dst
+     *
+     * Moves in at most two contiguous pieces (memcpy for trivially copyable types).
+     * dst must hold count constructed objects, which are move-assigned.
+     *
+     * @return Number of elements removed
+     */
+    size_type pop_front_n(T* dst, size_type count) {
+        const size_type n = count < size() ? count : size();
+        const size_type first = contiguous_from(m_head, n);
+        move_out(dst, slot(m_head), first);
+        move_out(dst + first, slot(m_head + first), n - first);
+        m_head += n;
+        return n;
+    }
+
+    /**
+     * @brief Get the elements as at most two contiguous segments, front to back
+     *
+     * The second segment is empty unless the contents wrap around the end of the buffer.
+     */
+    std::pair<BufferView<T>, BufferView<T>> segments() noexcept {
+        const size_type first = contiguous_from(m_head, size());
+        return {BufferView<T>{slot(m_head), first},
+                BufferView<T>{slot(m_head + first), size() - first}};
+    }
+
+    /** @brief Get the elements as at most two contiguous segments (const) */
+    std::pair<BufferView<const T>, BufferView<const T>> segments() const noexcept {
+        const size_type first = contiguous_from(m_head, size());
+        return {BufferView<const T>{slot(m_head), first},
+                BufferView<const T>{slot(m_head + first), size() - first}};
+    }
+
+    /**
+     * @brief Drop count elements from the front after processing them in place
+     * @param count Number of elements to drop (at most size())
+     */
+    void consume_front(size_type count) noexcept {
+        assert(count <= size() && "StackRing: consume past end");
+        if constexpr (std::is_trivially_destructible<T>::value) {
+            m_head += count;
+        } else {
+            for (size_type i = 0; i < count; ++i) {
+                pop_front();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the free space behind the back as at most two writable segments
+     *
+     * Fill the segments in order, then publish the written elements with commit_back().
+     *
+     * @note Only available when T is trivially copyable
+     */
+    template <typename U = T>
+    std::enable_if_t<std::is_trivially_copyable<U>::value,
+                     std::pair<BufferView<T>, BufferView<T>>>
+    free_segments() noexcept {
+        const size_type space = N - size();
+        const size_type first = contiguous_from(m_tail, space);
+        return {BufferView<T>{slot(m_tail), first},
+                BufferView<T>{slot(m_tail + first), space - first}};
+    }
+
+    /**
+     * @brief Publish count elements written through free_segments()
+     * @note Only available when T is trivially copyable
+     */
+    template <typename U = T>
+    std::enable_if_t<std::is_trivially_copyable<U>::value> commit_back(size_type count) noexcept {
+        assert(count <= N - size() && "StackRing: commit past capacity");
+        m_tail += count;
+    }
+
+    /** @brief Access element at position idx from the front (unchecked) */
+    T& operator[](std::size_t idx) noexcept { return *slot(m_head + idx); }
+    /** @brief Access element at position idx from the front (unchecked, const) */
+    const T& operator[](std::size_t idx) const noexcept { return *slot(m_head + idx); }
+
+    /** @brief Access the front element (must not be empty) */
+    T& front() noexcept { return *slot(m_head); }
+    /** @brief Access the front element (must not be empty, const) */
+    const T& front() const noexcept { return *slot(m_head); }
+    /** @brief Access the back element (must not be empty) */
+    T& back() noexcept { return *slot(m_tail - 1); }
+    /** @brief Access the back element (must not be empty, const) */
+    const T& back() const noexcept { return *slot(m_tail - 1); }
+
+    /** @brief Get number of elements */
+    std::size_t size() const noexcept { return m_tail - m_head; }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_tail == m_head; }
+    /** @brief Check if size has reached capacity */
+    bool full() const noexcept { return size() == N; }
+    /** @brief Remove all elements */
+    void clear() noexcept {
+        if constexpr (std::is_trivially_destructible<T>::value) {
+            m_head = m_tail;
+        } else {
+            while (!empty()) {
+                pop_front();
+            }
+        }
+    }
+
+   private:
+    static constexpr size_type mask = N - 1;
+
+    T* slot(size_type counter) noexcept {
+        return reinterpret_cast<T*>(m_storage) + (counter & mask);
+    }
+    const T* slot(size_type counter) const noexcept {
+        return reinterpret_cast<const T*>(m_storage) + (counter & mask);
+    }
+
+    /// How many of n elements starting at counter fit before the buffer wraps
+    static size_type contiguous_from(size_type counter, size_type n) noexcept {
+        const size_type to_end = N - (counter & mask);
+        return n < to_end ? n : to_end;
+    }
+
+    /// Move-assign count elements into dst and destroy the sources
+    static void move_out(T* dst, T* src, size_type count) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(dst), src, count * sizeof(T));
+            }
+        } else {
+            for (size_type i = 0; i < count; ++i) {
+                dst[i] = std::move(src[i]);
+            }
+            stack_alloc_internal::destroy_n(src, count);
+        }
+    }
+
+    /// Take other's elements; this must be empty
+    void take(StackRing& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        const size_type count = other.size();
+        const size_type first = contiguous_from(other.m_head, count);
+        T* dst = reinterpret_cast<T*>(m_storage);
+        stack_alloc_internal::relocate_n(dst, other.slot(other.m_head), first);
+        stack_alloc_internal::relocate_n(dst + first, other.slot(other.m_head + first),
+                                         count - first);
+        m_head = 0;
+        m_tail = count;
+        other.m_head = other.m_tail = 0;
+    }
+
+    /// Inline element storage
+    alignas(T) unsigned char m_storage[N * sizeof(T)];
+    /// Free-running counter of the front element
+    size_type m_head;
+    /// Free-running counter one past the back element
+    size_type m_tail;
+};
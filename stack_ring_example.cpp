@@ -0,0 +1,49 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "stack_ring.hpp"
+
+int main() {
+    // Example 1: FIFO and double-ended use
+    std::cout << "Example 1: Push and pop at both ends\n";
+    StackRing<int, 8> ring;
+    ring.push_back(2);
+    ring.push_back(3);
+    ring.push_front(1);
+    ring.push_back(4);
+    ring.pop_front();
+    std::cout << "Front: " << ring.front() << ", back: " << ring.back()
+              << ", size: " << ring.size() << "\n\n";
+
+    // Example 2: A receive window filled and parsed in place across the wrap
+    std::cout << "Example 2: Zero-copy receive window\n";
+    StackRing<char, 16> window;
+    const char* chunks[] = {"GET /a\n", "GET /bb\n", "GET /c\n"};
+    for (const char* chunk : chunks) {
+        auto [first, second] = window.free_segments();
+        const std::size_t len = std::strlen(chunk);
+        const std::size_t in_first = len < first.m_size ? len : first.m_size;
+        std::memcpy(first.begin(), chunk, in_first);
+        std::memcpy(second.begin(), chunk + in_first, len - in_first);
+        window.commit_back(len);
+
+        auto [a, b] = window.segments();
+        std::string line(a.begin(), a.end());
+        line.append(b.begin(), b.end());
+        std::cout << "segments " << a.m_size << "+" << b.m_size << ": " << line;
+        window.consume_front(line.size());
+    }
+    std::cout << "\n";
+
+    // Example 3: Bulk copy in and out
+    std::cout << "Example 3: Bulk push/pop\n";
+    StackRing<int, 4> small;
+    int in[] = {10, 20, 30, 40, 50};
+    std::cout << "Pushed " << small.push_back_n(in, 5) << " of 5\n";
+    int out[4] = {};
+    std::cout << "Popped " << small.pop_front_n(out, 3) << ": " << out[0] << " " << out[1] << " "
+              << out[2] << "\n";
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "buffer_view.hpp"
+#include "stack_allocator.hpp"
+
+namespace soa_internal {
+
+/// Inline uninitialized storage for one column of N elements
+template <typename T, std::size_t N>
+struct Column {
+    alignas(T) unsigned char m_storage[N * sizeof(T)];
+
+    /// User-provided so std::tuple's value-initialization leaves the storage untouched
+    Column() noexcept {}
+
+    T* data() noexcept { return reinterpret_cast<T*>(m_storage); }
+    const T* data() const noexcept { return reinterpret_cast<const T*>(m_storage); }
+};
+
+}  // namespace soa_internal
+
+/**
+ * @brief Fixed-capacity structure-of-arrays container with inline storage
+ *
+ * Each field of a record is stored in its own contiguous inline array, so code that
+ * scans one field at a time (all x coordinates, all prices) streams only that field
+ * through the cache instead of whole records. Columns are exposed as BufferViews and
+ * rows can be pushed as separate values or as a tuple.
+ *
+ * @tparam N Maximum number of rows
+ * @tparam Ts Column types, one per field
+ *
+ * Example usage:
+ * @code
+ * StackSoA<1024, float, float, float> particles;   // x, y, mass
+ * particles.push_back(1.0f, 2.0f, 0.5f);
+ *
+ * for (float& x : particles.column<0>()) {         // touches only the x array
+ *     x += dt;
+ * }
+ * @endcode
+ *
+ * @note This class is not copyable
+ * @note push_back asserts when the container is full
+ */
+template <std::size_t N, typename... Ts>
+class StackSoA {
+    static_assert(sizeof...(Ts) != 0, "StackSoA needs at least one column");
+
+   public:
+    using size_type = std::size_t;
+    using row_type = std::tuple<Ts...>;
+
+    /// Type of column I
+    template <std::size_t I>
+    using column_type = std::tuple_element_t<I, row_type>;
+
+    /// Number of columns
+    static constexpr std::size_t column_count = sizeof...(Ts);
+
+    /** @brief Construct an empty container */
+    StackSoA() noexcept : m_size(0) {}
+
+    StackSoA(const StackSoA&) = delete;
+    StackSoA& operator=(const StackSoA&) = delete;
+
+    /// Destroys all rows
+    ~StackSoA() { clear(); }
+
+    /**
+     * @brief Append a row given one value per column
+     * @return Index of the new row
+     */
+    template <typename... Args,
+              std::enable_if_t<std::conjunction<std::is_constructible<Ts, Args&&>...>::value,
+                               int> = 0>
+    size_type push_back(Args&&... values) {
+        assert(!full() && "StackSoA: capacity exceeded");
+        construct_row(std::index_sequence_for<Ts...>{}, std::forward<Args>(values)...);
+        return m_size++;
+    }
+
+    /**
+     * @brief Append a row given as a tuple
+     * @return Index of the new row
+     */
+    size_type push_back(const row_type& row) {
+        return std::apply([this](const Ts&... values) { return push_back(values...); }, row);
+    }
+
+    /** @brief Remove the last row (must not be empty) */
+    void pop_back() noexcept {
+        assert(!empty() && "StackSoA: pop_back on empty container");
+        --m_size;
+        destroy_rows(std::index_sequence_for<Ts...>{}, m_size, 1);
+    }
+
+    /** @brief Get column I as a contiguous view of size() elements */
+    template <std::size_t I>
+    BufferView<column_type<I>> column() noexcept {
+        return {std::get<I>(m_columns).data(), m_size};
+    }
+
+    /** @brief Get column I as a contiguous view of size() elements (const) */
+    template <std::size_t I>
+    BufferView<const column_type<I>> column() const noexcept {
+        return {std::get<I>(m_columns).data(), m_size};
+    }
+
+    /** @brief Access the column I field of row idx (unchecked) */
+    template <std::size_t I>
+    column_type<I>& get(size_type idx) noexcept {
+        return std::get<I>(m_columns).data()[idx];
+    }
+
+    /** @brief Access the column I field of row idx (unchecked, const) */
+    template <std::size_t I>
+    const column_type<I>& get(size_type idx) const noexcept {
+        return std::get<I>(m_columns).data()[idx];
+    }
+
+    /** @brief Get row idx as a tuple of references into the columns (unchecked) */
+    std::tuple<Ts&...> row(size_type idx) noexcept {
+        return row_refs(std::index_sequence_for<Ts...>{}, idx);
+    }
+
+    /** @brief Get a copy of row idx as a tuple (unchecked) */
+    row_type row(size_type idx) const {
+        return row_copy(std::index_sequence_for<Ts...>{}, idx);
+    }
+
+    /** @brief Get number of rows */
+    std::size_t size() const noexcept { return m_size; }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_size == 0; }
+    /** @brief Check if size has reached capacity */
+    bool full() const noexcept { return m_size == N; }
+    /** @brief Remove all rows */
+    void clear() noexcept {
+        destroy_rows(std::index_sequence_for<Ts...>{}, 0, m_size);
+        m_size = 0;
+    }
+
+   private:
+    /// Construct one element per column at m_size; if a column throws, the columns
+    /// already constructed are destroyed so every column keeps m_size elements
+    template <std::size_t... Is, typename... Args>
+    void construct_row(std::index_sequence<Is...>, Args&&... values) {
+        std::size_t constructed = 0;
+        try {
+            ((::new (static_cast<void*>(std::get<Is>(m_columns).data() + m_size))
+                  column_type<Is>(std::forward<Args>(values)),
+              ++constructed),
+             ...);
+        } catch (...) {
+            ((Is < constructed
+                  ? stack_alloc_internal::destroy_n(std::get<Is>(m_columns).data() + m_size, 1)
+                  : void()),
+             ...);
+            throw;
+        }
+    }
+
+    template <std::size_t... Is>
+    void destroy_rows(std::index_sequence<Is...>, size_type first, size_type count) noexcept {
+        (stack_alloc_internal::destroy_n(std::get<Is>(m_columns).data() + first, count), ...);
+    }
+
+    template <std::size_t... Is>
+    std::tuple<Ts&...> row_refs(std::index_sequence<Is...>, size_type idx) noexcept {
+        return std::tuple<Ts&...>{std::get<Is>(m_columns).data()[idx]...};
+    }
+
+    template <std::size_t... Is>
+    row_type row_copy(std::index_sequence<Is...>, size_type idx) const {
+        return row_type{std::get<Is>(m_columns).data()[idx]...};
+    }
+
+    /// One inline array per field
+    std::tuple<soa_internal::Column<Ts, N>...> m_columns;
+    /// Number of rows, in the smallest type that can hold N
+    stack_alloc_internal::size_type_for<N> m_size;
+};
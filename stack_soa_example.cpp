@@ -0,0 +1,41 @@
+#include <cstdint>
+#include <iostream>
+#include <tuple>
+
+#include "stack_soa.hpp"
+
+int main() {
+    // Example 1: Particles scanned one field at a time
+    std::cout << "Example 1: Particle columns\n";
+    enum { X, Y, Mass };
+    StackSoA<256, float, float, float> particles;
+    for (int i = 0; i < 8; ++i) {
+        particles.push_back(i * 1.0f, i * 0.5f, 1.0f + i);
+    }
+    for (float& x : particles.column<X>()) {  // streams only the x array
+        x += 0.25f;
+    }
+    float total_mass = 0;
+    for (float m : particles.column<Mass>()) {
+        total_mass += m;
+    }
+    std::cout << "x[3] = " << particles.get<X>(3) << ", total mass = " << total_mass << "\n";
+    std::cout << "Bytes per column: " << particles.column<Y>().m_size * sizeof(float) << "\n\n";
+
+    // Example 2: Order book rows pushed as tuples, filtered by one column
+    std::cout << "Example 2: Orders pushed as tuples\n";
+    StackSoA<64, std::uint64_t, double, std::int32_t> orders;  // id, price, quantity
+    orders.push_back(std::make_tuple(std::uint64_t{101}, 99.5, 10));
+    orders.push_back(std::make_tuple(std::uint64_t{102}, 101.0, -4));
+    orders.push_back(std::make_tuple(std::uint64_t{103}, 100.25, 7));
+
+    auto prices = orders.column<1>();
+    for (std::size_t i = 0; i < prices.m_size; ++i) {
+        if (prices.m_data[i] >= 100.0) {
+            auto [id, price, quantity] = orders.row(i);
+            std::cout << "order " << id << " at " << price << " x " << quantity << "\n";
+        }
+    }
+
+    return 0;
+}
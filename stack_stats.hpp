@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+
+#include "type_signature.hpp"
+
+/// Set to 1 to collect per-instantiation StackAllocator/StackVector statistics
+#ifndef STACK_VEC_STATS
+#define STACK_VEC_STATS 0
+#endif
+
+/**
+ * @brief Opt-in usage counters for fixed-size buffers
+ *
+ * When STACK_VEC_STATS is 0 (the default) every hook sits behind `if constexpr (enabled)`
+ * and the instrumented containers compile to exactly the uninstrumented code. When it
+ * is 1, each StackAllocator / StackVector instantiation gets one set of counters shared
+ * by all its instances, registered on first use so dump() can list them all.
+ *
+ * Example usage (built with -DSTACK_VEC_STATS=1):
+ * @code
+ * run_workload();
+ * stack_stats::dump(std::cout);
+ * // StackVector<int, 64, false>  capacity 256 B  peak 48 B (18%)  allocations 12 ...
+ * @endcode
+ */
+namespace stack_stats {
+
+/// Whether statistics are compiled in
+constexpr bool enabled = STACK_VEC_STATS != 0;
+
+/**
+ * @brief Counters shared by all instances of one template instantiation
+ *
+ * All counters use relaxed atomics so instrumented builds stay usable from any thread.
+ */
+struct Counters {
+    /// Compiler-generated signature containing the instantiation's type name
+    const char* signature;
+    /// Buffer size of the instantiation in bytes
+    std::size_t capacity_bytes;
+    /// Highest buffer offset (bytes in use) ever observed
+    std::atomic<std::size_t> peak_bytes{0};
+    /// Number of successful allocations (elements added, for StackVector)
+    std::atomic<std::size_t> allocations{0};
+    /// Number of allocations rejected because the buffer was full
+    std::atomic<std::size_t> failed_allocations{0};
+    /// Bytes freed out of LIFO order and therefore not reclaimed
+    std::atomic<std::size_t> wasted_bytes{0};
+    /// Next entry in the global registry
+    Counters* next = nullptr;
+
+    Counters(const char* sig, std::size_t capacity) noexcept
+        : signature(sig), capacity_bytes(capacity) {}
+
+    /** @brief Raise peak_bytes to offset if it is higher */
+    void record_peak(std::size_t offset) noexcept {
+        std::size_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while (offset > peak &&
+               !peak_bytes.compare_exchange_weak(peak, offset, std::memory_order_relaxed)) {
+        }
+    }
+
+    /** @brief Extract the instantiation's type name from the signature */
+    std::string_view name() const noexcept { return type_signature_internal::type_name(signature); }
+};
+
+namespace detail {
+
+/// Head of the intrusive list of every registered Counters block
+inline std::atomic<Counters*> registry_head{nullptr};
+
+inline Counters* register_counters(Counters* counters) noexcept {
+    Counters* head = registry_head.load(std::memory_order_relaxed);
+    do {
+        counters->next = head;
+    } while (!registry_head.compare_exchange_weak(head, counters, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    return counters;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Get the counters for one instantiation, registering them on first use
+ *
+ * @tparam Owner The instrumented class instantiation
+ * @param capacity_bytes Buffer size of the instantiation in bytes
+ */
+template <typename Owner>
+Counters& counters_for(std::size_t capacity_bytes) noexcept {
+    static Counters counters{type_signature_internal::signature<Owner>(), capacity_bytes};
+    static Counters* registered = detail::register_counters(&counters);
+    (void)registered;
+    return counters;
+}
+
+/**
+ * @brief Print one line per registered instantiation
+ *
+ * @tparam Stream Any std::ostream-like type
+ * @param os Output stream
+ */
+template <typename Stream>
+void dump(Stream& os) {
+    for (const Counters* c = detail::registry_head.load(std::memory_order_acquire); c;
+         c = c->next) {
+        const std::size_t peak = c->peak_bytes.load(std::memory_order_relaxed);
+        os << c->name() << "  capacity " << c->capacity_bytes << " B  peak " << peak << " B ("
+           << (c->capacity_bytes ? peak * 100 / c->capacity_bytes : 0) << "%)  allocations "
+           << c->allocations.load(std::memory_order_relaxed) << "  failed "
+           << c->failed_allocations.load(std::memory_order_relaxed) << "  wasted "
+           << c->wasted_bytes.load(std::memory_order_relaxed) << " B\n";
+    }
+}
+
+}  // namespace stack_stats
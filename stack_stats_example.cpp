@@ -0,0 +1,63 @@
+#include <iostream>
+#include <vector>
+
+#include "stack_allocator.hpp"
+
+static_assert(stack_stats::enabled, "build with -DSTACK_VEC_STATS=ON");
+
+// Report a counter that does not hold the expected value
+static bool check(const char* what, bool ok) {
+    if (!ok) {
+        std::cout << "unexpected counter: " << what << "\n";
+    }
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+
+    // Example 1: StackVector counts the elements added and the largest size reached
+    std::cout << "Example 1: StackVector push path\n";
+    using Samples = StackVector<int, 16>;
+    {
+        Samples samples;
+        for (int i = 0; i < 5; ++i) {
+            samples.push_back(i);
+        }
+        samples.pop_back();
+        samples.push_back(42);
+    }
+    const stack_stats::Counters& vec = Samples::stats();
+    std::cout << "allocations " << vec.allocations << ", peak " << vec.peak_bytes << " of "
+              << vec.capacity_bytes << " B\n\n";
+    ok &= check("StackVector allocations", vec.allocations == 6);
+    ok &= check("StackVector peak", vec.peak_bytes == 5 * sizeof(int));
+    ok &= check("StackVector failures", vec.failed_allocations == 0);
+
+    // Example 2: A growing std::vector reallocates inside the buffer, then spills to the heap
+    std::cout << "Example 2: StackAllocator reallocate and overflow paths\n";
+    using SpillAlloc =
+        stack_alloc_internal::StackAllocator<int, 64, true, 0, overflow_policy::Heap>;
+    {
+        std::vector<int, SpillAlloc> values;
+        values.reserve(4);   // first block at the start of the buffer
+        values.reserve(8);   // second block after it; the first is freed out of order
+        values.reserve(16);  // does not fit: counted as failed and served by the heap
+        values.assign(16, 7);
+    }
+    const stack_stats::Counters& alloc = SpillAlloc::stats();
+    std::cout << "allocations " << alloc.allocations << ", failed " << alloc.failed_allocations
+              << ", wasted " << alloc.wasted_bytes << " B, peak " << alloc.peak_bytes << " of "
+              << alloc.capacity_bytes << " B\n\n";
+    ok &= check("StackAllocator allocations", alloc.allocations == 2);
+    ok &= check("StackAllocator failures", alloc.failed_allocations == 1);
+    ok &= check("StackAllocator wasted bytes", alloc.wasted_bytes > 0);
+    ok &= check("StackAllocator peak", alloc.peak_bytes > 0 &&
+                                           alloc.peak_bytes <= alloc.capacity_bytes);
+
+    // Example 3: One line per instantiation used so far
+    std::cout << "Example 3: stack_stats::dump\n";
+    stack_stats::dump(std::cout);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "stack_allocator.hpp"
+
+/**
+ * @brief Fixed-capacity string with inline storage and allocation-free formatting
+ *
+ * Characters live directly in the object, like StackVector elements. Text, integers
+ * and floating-point values are appended in place (numbers via std::to_chars), so
+ * building a message never touches the heap. Appends that do not fit are truncated
+ * and the truncation is recorded instead of failing.
+ *
+ * @tparam N Maximum number of characters (a terminating '\0' is always kept after them)
+ *
+ * Example usage:
+ * @code
+ * StackString<64> msg;
+ * msg.append("disk ").append(device).append(" at ").append(percent).append('%');
+ * report(msg.view());  // "disk /dev/sdb at 97%"
+ * @endcode
+ *
+ * @note Numbers are appended whole or not at all; a number that does not fit in the
+ *       remaining space is omitted and truncated() is set
+ * @note Converts implicitly to std::string_view, so it can be passed wherever the
+ *       runners expect a message
+ */
+template <std::size_t N>
+class StackString {
+   public:
+    using value_type = char;
+    using size_type = std::size_t;
+    using iterator = char*;
+    using const_iterator = const char*;
+
+    /** @brief Construct an empty string */
+    StackString() noexcept : m_size(0), m_truncated(false) { m_data[0] = '\0'; }
+
+    /**
+     * @brief Construct from text, truncating to N characters
+     * @param text Initial contents
+     */
+    StackString(std::string_view text) noexcept : StackString() { append(text); }
+
+    /**
+     * @brief Append text, truncating at capacity
+     * @return Reference to this string for chaining
+     */
+    StackString& append(std::string_view text) noexcept {
+        size_type count = text.size();
+        if (count > N - m_size) {
+            count = N - m_size;
+            m_truncated = true;
+        }
+        if (count != 0) {
+            std::memcpy(m_data + m_size, text.data(), count);
+        }
+        m_size = static_cast<count_type>(m_size + count);
+        m_data[m_size] = '\0';
+        return *this;
+    }
+
+    /**
+     * @brief Append a null-terminated string, truncating at capacity
+     * @return Reference to this string for chaining
+     */
+    StackString& append(const char* text) noexcept { return append(std::string_view{text}); }
+
+    /**
+     * @brief Append a single character, dropped if full
+     * @return Reference to this string for chaining
+     */
+    StackString& append(char c) noexcept {
+        if (m_size == N) {
+            m_truncated = true;
+            return *this;
+        }
+        m_data[m_size++] = c;
+        m_data[m_size] = '\0';
+        return *this;
+    }
+
+    /**
+     * @brief Append "true" or "false"
+     * @return Reference to this string for chaining
+     */
+    StackString& append(bool value) noexcept {
+        return append(value ? std::string_view{"true"} : std::string_view{"false"});
+    }
+
+    /**
+     * @brief Append an integer in the given base
+     *
+     * @param value Integer to format
+     * @param base Number base, 2 to 36 (default: 10)
+     * @return Reference to this string for chaining
+     */
+    template <typename Int, std::enable_if_t<std::is_integral<Int>::value &&
+                                                 !std::is_same<Int, char>::value &&
+                                                 !std::is_same<Int, bool>::value,
+                                             int> = 0>
+    StackString& append(Int value, int base = 10) noexcept {
+        return commit(std::to_chars(end(), m_data + N, value, base));
+    }
+
+    /**
+     * @brief Append a floating-point value in its shortest round-trip form
+     * @return Reference to this string for chaining
+     */
+    template <typename Float,
+              std::enable_if_t<std::is_floating_point<Float>::value, int> = 0>
+    StackString& append(Float value) noexcept {
+        return commit(std::to_chars(end(), m_data + N, value));
+    }
+
+    /**
+     * @brief Append a floating-point value with a fixed number of decimals
+     *
+     * @param value Value to format
+     * @param precision Digits after the decimal point
+     * @return Reference to this string for chaining
+     */
+    template <typename Float,
+              std::enable_if_t<std::is_floating_point<Float>::value, int> = 0>
+    StackString& append_fixed(Float value, int precision) noexcept {
+        return commit(
+            std::to_chars(end(), m_data + N, value, std::chars_format::fixed, precision));
+    }
+
+    /** @brief Append anything append() accepts */
+    template <typename V>
+    StackString& operator+=(const V& value) noexcept {
+        return append(value);
+    }
+
+    /** @brief Get the contents as a string_view */
+    std::string_view view() const noexcept { return std::string_view{m_data, m_size}; }
+    /** @brief Implicit conversion to string_view */
+    operator std::string_view() const noexcept { return view(); }
+    /** @brief Get a null-terminated C string */
+    const char* c_str() const noexcept { return m_data; }
+    /** @brief Get pointer to the characters */
+    const char* data() const noexcept { return m_data; }
+
+    /** @brief Access character at index (unchecked) */
+    char& operator[](std::size_t idx) noexcept { return m_data[idx]; }
+    /** @brief Access character at index (unchecked, const) */
+    const char& operator[](std::size_t idx) const noexcept { return m_data[idx]; }
+
+    /** @brief Get iterator to beginning */
+    iterator begin() noexcept { return m_data; }
+    /** @brief Get iterator to end */
+    iterator end() noexcept { return m_data + m_size; }
+    /** @brief Get const iterator to beginning */
+    const_iterator begin() const noexcept { return m_data; }
+    /** @brief Get const iterator to end */
+    const_iterator end() const noexcept { return m_data + m_size; }
+
+    /** @brief Get number of characters */
+    std::size_t size() const noexcept { return m_size; }
+    /** @brief Get capacity (always N) */
+    static constexpr std::size_t capacity() { return N; }
+    /** @brief Check if empty */
+    bool empty() const noexcept { return m_size == 0; }
+    /** @brief Check whether any append was cut short since the last clear() */
+    bool truncated() const noexcept { return m_truncated; }
+    /** @brief Remove all characters and reset the truncation flag */
+    void clear() noexcept {
+        m_size = 0;
+        m_truncated = false;
+        m_data[0] = '\0';
+    }
+
+    /** @brief Compare contents with any string-like value */
+    friend bool operator==(const StackString& a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+    /** @brief Compare contents with any string-like value */
+    friend bool operator!=(const StackString& a, std::string_view b) noexcept {
+        return a.view() != b;
+    }
+
+   private:
+    using count_type = stack_alloc_internal::size_type_for<N>;
+
+    /// Accept a to_chars result, or flag truncation if the number did not fit
+    StackString& commit(std::to_chars_result result) noexcept {
+        if (result.ec != std::errc{}) {
+            m_truncated = true;
+        } else {
+            m_size = static_cast<count_type>(result.ptr - m_data);
+        }
+        m_data[m_size] = '\0';
+        return *this;
+    }
+
+    /// Characters followed by a terminating '\0'
+    char m_data[N + 1];
+    /// Number of characters, in the smallest type that can hold N
+    count_type m_size;
+    /// Whether an append was cut short
+    bool m_truncated;
+};
+
+// Footprint guarantees: characters, terminator, a size field sized for N and the flag
+static_assert(sizeof(StackString<30>) == 33, "1-byte size for N <= 255");
+static_assert(sizeof(StackString<61>) == 64, "one cache line for 61 characters");
@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "parallel_runner.hpp"
+#include "stack_string.hpp"
+
+int main() {
+    // Example 1: Formatting text and numbers into an inline buffer
+    std::cout << "Example 1: Allocation-free formatting\n";
+    StackString<64> msg;
+    msg.append("disk ").append("/dev/sdb").append(" at ").append(97).append('%');
+    std::cout << msg.view() << " (" << msg.size() << " of " << msg.capacity() << " chars)\n\n";
+
+    // Example 2: Floating-point values
+    std::cout << "Example 2: Floating-point formatting\n";
+    StackString<48> load;
+    load += "load average ";
+    load += 1.25;
+    load += ", ratio ";
+    load.append_fixed(2.0 / 3.0, 3);
+    std::cout << load.view() << "\n\n";
+
+    // Example 3: Truncation on overflow instead of failure
+    std::cout << "Example 3: Truncation\n";
+    StackString<16> small;
+    small.append("this message is far too long for sixteen characters");
+    std::cout << "'" << small.view() << "', truncated: " << std::boolalpha << small.truncated()
+              << "\n\n";
+
+    // Example 4: Dynamic context for runner failures
+    std::cout << "Example 4: Failure context for ParallelRunner\n";
+    int disk_usage = 97;
+    auto checks = make_parallel_runner(
+        [&] { return disk_usage < 90; }, "Disk space",
+        [] { return true; }, "Memory");
+    checks.run();
+
+    for (std::size_t i = 0; i < checks.size(); ++i) {
+        if (!checks.succeeded(i)) {
+            StackString<80> detail{checks.error_message(i)};
+            detail.append(": /dev/sdb at ").append(disk_usage).append('%');
+            std::cout << detail.view() << "\n";
+        }
+    }
+
+    return 0;
+}
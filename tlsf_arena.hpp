@@ -0,0 +1,449 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "bit_ops.hpp"
+#include "stack_allocator.hpp"
+#include "stack_arena.hpp"
+
+namespace tlsf_internal {
+
+/**
+ * @brief Header in front of every block
+ *
+ * prev_phys and size are always valid. next_free and prev_free are only meaningful
+ * while the block is free and overlap the start of the payload otherwise.
+ */
+struct Block {
+    Block* prev_phys;  ///< Physically preceding block
+    std::size_t size;  ///< Payload size in bytes, low bits hold the flags below
+    Block* next_free;  ///< Next block in the same free list
+    Block* prev_free;  ///< Previous block in the same free list
+};
+
+/// Block sizes and payload addresses are multiples of this
+constexpr std::size_t granularity = 16;
+/// Bytes from a block header to its payload
+constexpr std::size_t overhead = 2 * sizeof(void*) > granularity ? 2 * sizeof(void*) : granularity;
+/// Smallest payload, large enough to hold the free-list links
+constexpr std::size_t min_payload = granularity;
+/// Smallest block including its header
+constexpr std::size_t min_block = overhead + min_payload;
+
+/// Flag in Block::size: this block is free
+constexpr std::size_t free_bit = 1;
+/// Flag in Block::size: the physically preceding block is free
+constexpr std::size_t prev_free_bit = 2;
+/// Mask that strips the flags from Block::size
+constexpr std::size_t size_mask = ~(granularity - 1);
+
+/// Second-level lists per power of two (log2)
+constexpr unsigned sl_log2 = 4;
+/// Second-level lists per power of two
+constexpr unsigned sl_count = 1u << sl_log2;
+/// Sizes below 2^fl_shift share first-level list 0, split linearly
+constexpr unsigned fl_shift = sl_log2 + 4;
+/// Blocks must be smaller than 2^fl_max bytes
+constexpr unsigned fl_max = sizeof(std::size_t) == 8 ? 40 : 30;
+/// Number of first-level lists
+constexpr unsigned fl_count = fl_max - fl_shift + 1;
+
+static_assert(sizeof(Block) <= min_block, "free-list links must fit in a minimum block");
+static_assert(fl_count <= 64 && sl_count <= 32, "bitmaps too narrow");
+
+}  // namespace tlsf_internal
+
+/**
+ * @brief General-purpose allocator with O(1) allocate and free inside a borrowed buffer
+ *
+ * Two-Level Segregated Fit (TLSF): free blocks are kept in lists indexed by the
+ * highest set bit of their size (first level) and the next four bits (second level),
+ * with a bitmap per level. allocate() finds a large-enough list with two
+ * find-first-set instructions and splits the block it takes; deallocate() merges the
+ * block with free physical neighbors through boundary tags. Neither walks a list, so
+ * both run in bounded constant time regardless of how many blocks exist, which makes
+ * it suitable for real-time code where malloc's tail latency is not acceptable.
+ *
+ * Unlike ArenaResource, blocks may be freed in any order and their space is reused.
+ * The interface matches the arenas, so ArenaAllocator<T, TlsfResource> works with any
+ * standard container, and the buffer can be inline (StackTlsfArena), a static array or
+ * a mapping such as an MmapArena's data().
+ *
+ * Example usage:
+ * @code
+ * StackTlsfArena<64 * 1024> heap;
+ * std::list<Order, ArenaAllocator<Order, TlsfResource>> book{
+ *     ArenaAllocator<Order, TlsfResource>{heap}};   // nodes freed in any order
+ *
+ * if (heap.fragmentation() > 0.5) {
+ *     // plenty free in total, but no single large block
+ * }
+ * @endcode
+ *
+ * @note This class does not throw exceptions; allocation failures return nullptr.
+ *       Failure is an expected condition here and does not assert.
+ * @note Every block carries a 16-byte header (two pointers) and is rounded up to 16
+ *       bytes. Requests are served from the next size class up, so an allocation of
+ *       exactly largest_free_block() bytes may fail.
+ * @note Not thread-safe; not copyable or movable
+ */
+class TlsfResource {
+   public:
+    using size_type = std::size_t;
+
+    /// Default alignment for allocations that do not specify one
+    static constexpr size_type default_alignment = alignof(std::max_align_t);
+
+    /**
+     * @brief Construct an allocator over an existing buffer
+     *
+     * @param buffer Start of the buffer to allocate from
+     * @param size Size of the buffer in bytes
+     * @note The buffer must outlive the allocator and every allocation made from it
+     */
+    TlsfResource(void* buffer, size_type size) noexcept
+        : m_begin(static_cast<char*>(buffer)), m_size(size) {
+        reset();
+    }
+
+    TlsfResource(const TlsfResource&) = delete;
+    TlsfResource& operator=(const TlsfResource&) = delete;
+
+    /**
+     * @brief Allocate bytes with the given alignment in O(1)
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the returned pointer, must be a power of two
+     * @return Pointer to the allocated memory, or nullptr if no free block is large
+     *         enough
+     */
+    void* allocate(size_type bytes, size_type align = default_alignment) noexcept {
+        using namespace tlsf_internal;
+        if (bytes > m_pool_size || align > m_pool_size) {
+            return nullptr;
+        }
+        size_type size = stack_alloc_internal::align_up(bytes, granularity);
+        if (size < min_payload) {
+            size = min_payload;
+        }
+        // Over-aligned requests reserve room to split off a leading free block
+        const size_type search = align > granularity ? size + align + min_block : size;
+
+        unsigned fl = 0;
+        unsigned sl = 0;
+        mapping_search(search, fl, sl);
+        if (fl >= fl_count) {
+            return nullptr;
+        }
+        Block* block = find_suitable(fl, sl);
+        if (block == nullptr) {
+            return nullptr;
+        }
+        remove_free(block);
+
+        if (align > granularity) {
+            block = trim_leading(block, align);
+        }
+        trim_trailing(block, size);
+
+        block->size &= ~free_bit;
+        next_phys(block)->size &= ~prev_free_bit;
+        return payload(block);
+    }
+
+    /**
+     * @brief Return a block in O(1), merging it with free neighbors
+     *
+     * @param p Pointer returned by allocate() (nullptr is ignored)
+     */
+    void deallocate(void* p, size_type = 0, size_type = default_alignment) noexcept {
+        using namespace tlsf_internal;
+        if (p == nullptr) {
+            return;
+        }
+        assert(owns(p) && "TlsfResource: pointer from another allocator");
+        Block* block = block_of(p);
+        assert((block->size & free_bit) == 0 && "TlsfResource: double free");
+
+        block->size |= free_bit;
+        if (block->size & prev_free_bit) {
+            Block* prev = block->prev_phys;
+            remove_free(prev);
+            prev->size += overhead + block_size(block);
+            block = prev;
+        }
+        Block* next = next_phys(block);
+        if (next->size & free_bit) {
+            remove_free(next);
+            block->size += overhead + block_size(next);
+            next = next_phys(block);
+        }
+        next->prev_phys = block;
+        next->size |= prev_free_bit;
+        insert_free(block);
+    }
+
+    /**
+     * @brief Release every allocation at once and start over with one free block
+     *
+     * @warning Objects still living in the buffer are not destroyed
+     */
+    void reset() noexcept {
+        using namespace tlsf_internal;
+        for (unsigned fl = 0; fl < fl_count; ++fl) {
+            m_sl_bitmap[fl] = 0;
+            for (unsigned sl = 0; sl < sl_count; ++sl) {
+                m_heads[fl][sl] = nullptr;
+            }
+        }
+        m_fl_bitmap = 0;
+        m_free_bytes = 0;
+        m_free_blocks = 0;
+        m_pool_size = 0;
+
+        // One free block followed by a zero-size, in-use sentinel so every block has a
+        // physical successor
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_begin);
+        const std::uintptr_t first = stack_alloc_internal::align_up(base, granularity);
+        const std::uintptr_t end = (base + m_size) & ~std::uintptr_t{granularity - 1};
+        if (m_begin == nullptr || end < first || end - first < min_block + overhead) {
+            return;
+        }
+        size_type payload_size = static_cast<size_type>(end - first) - 2 * overhead;
+        const size_type max_block = (size_type{1} << fl_max) - granularity;
+        if (payload_size > max_block) {
+            payload_size = max_block;
+        }
+
+        Block* block = reinterpret_cast<Block*>(first);
+        block->prev_phys = nullptr;
+        block->size = payload_size | free_bit;
+        Block* sentinel = next_phys(block);
+        sentinel->prev_phys = block;
+        sentinel->size = prev_free_bit;
+        m_pool_size = payload_size;
+        insert_free(block);
+    }
+
+    /** @brief Check whether p points into this allocator's buffer */
+    bool owns(const void* p) const noexcept {
+        const char* ptr = static_cast<const char*>(p);
+        return ptr >= m_begin && ptr < m_begin + m_size;
+    }
+
+    /** @brief Get the usable size of the buffer in bytes (after alignment and headers) */
+    size_type capacity() const noexcept { return m_pool_size; }
+    /** @brief Get number of bytes held by live allocations, including block headers */
+    size_type used() const noexcept { return m_pool_size - m_free_bytes; }
+    /** @brief Get total payload bytes in free blocks */
+    size_type free_bytes() const noexcept { return m_free_bytes; }
+    /** @brief Get number of free blocks */
+    size_type free_blocks() const noexcept { return m_free_blocks; }
+
+    /**
+     * @brief Get the payload size of the largest free block
+     *
+     * Scans only the highest non-empty free list, which holds blocks within 1/16 of
+     * each other in size.
+     */
+    size_type largest_free_block() const noexcept {
+        using namespace tlsf_internal;
+        if (m_fl_bitmap == 0) {
+            return 0;
+        }
+        const unsigned fl = bit_internal::highest_bit(m_fl_bitmap);
+        const unsigned sl = bit_internal::highest_bit(m_sl_bitmap[fl]);
+        size_type largest = 0;
+        for (const Block* b = m_heads[fl][sl]; b != nullptr; b = b->next_free) {
+            if (block_size(b) > largest) {
+                largest = block_size(b);
+            }
+        }
+        return largest;
+    }
+
+    /**
+     * @brief Get the share of free memory outside the largest free block
+     *
+     * @return 0 when all free memory is one block (or none is free), approaching 1
+     *         as free memory is scattered over many small blocks
+     */
+    double fragmentation() const noexcept {
+        if (m_free_bytes == 0) {
+            return 0.0;
+        }
+        return 1.0 - static_cast<double>(largest_free_block()) / static_cast<double>(m_free_bytes);
+    }
+
+   private:
+    using Block = tlsf_internal::Block;
+
+    static size_type block_size(const Block* b) noexcept {
+        return b->size & tlsf_internal::size_mask;
+    }
+    static char* payload(Block* b) noexcept {
+        return reinterpret_cast<char*>(b) + tlsf_internal::overhead;
+    }
+    static Block* block_of(void* p) noexcept {
+        return reinterpret_cast<Block*>(static_cast<char*>(p) - tlsf_internal::overhead);
+    }
+    static Block* next_phys(Block* b) noexcept {
+        return reinterpret_cast<Block*>(payload(b) + block_size(b));
+    }
+
+    /// Free-list indices of the list a block of this size belongs to
+    static void mapping_insert(size_type size, unsigned& fl, unsigned& sl) noexcept {
+        using namespace tlsf_internal;
+        if (size < (size_type{1} << fl_shift)) {
+            fl = 0;
+            sl = static_cast<unsigned>(size >> (fl_shift - sl_log2));
+        } else {
+            const unsigned top = bit_internal::highest_bit(size);
+            sl = static_cast<unsigned>(size >> (top - sl_log2)) ^ sl_count;
+            fl = top - (fl_shift - 1);
+        }
+    }
+
+    /// Indices of the first list whose every block is at least size bytes
+    static void mapping_search(size_type size, unsigned& fl, unsigned& sl) noexcept {
+        using namespace tlsf_internal;
+        if (size >= (size_type{1} << fl_shift)) {
+            size += (size_type{1} << (bit_internal::highest_bit(size) - sl_log2)) - 1;
+        }
+        mapping_insert(size, fl, sl);
+    }
+
+    /// Head of the first non-empty list at or above (fl, sl), or nullptr
+    Block* find_suitable(unsigned fl, unsigned sl) const noexcept {
+        using namespace tlsf_internal;
+        std::uint32_t sl_map = m_sl_bitmap[fl] & (~std::uint32_t{0} << sl);
+        if (sl_map == 0) {
+            if (fl + 1 >= fl_count) {
+                return nullptr;
+            }
+            const std::uint64_t fl_map = m_fl_bitmap & (~std::uint64_t{0} << (fl + 1));
+            if (fl_map == 0) {
+                return nullptr;
+            }
+            fl = bit_internal::lowest_bit(fl_map);
+            sl_map = m_sl_bitmap[fl];
+        }
+        sl = bit_internal::lowest_bit(sl_map);
+        return m_heads[fl][sl];
+    }
+
+    void insert_free(Block* b) noexcept {
+        unsigned fl = 0;
+        unsigned sl = 0;
+        mapping_insert(block_size(b), fl, sl);
+        Block* head = m_heads[fl][sl];
+        b->next_free = head;
+        b->prev_free = nullptr;
+        if (head != nullptr) {
+            head->prev_free = b;
+        }
+        m_heads[fl][sl] = b;
+        m_fl_bitmap |= std::uint64_t{1} << fl;
+        m_sl_bitmap[fl] |= std::uint32_t{1} << sl;
+        m_free_bytes += block_size(b);
+        ++m_free_blocks;
+    }
+
+    void remove_free(Block* b) noexcept {
+        unsigned fl = 0;
+        unsigned sl = 0;
+        mapping_insert(block_size(b), fl, sl);
+        if (b->prev_free != nullptr) {
+            b->prev_free->next_free = b->next_free;
+        } else {
+            m_heads[fl][sl] = b->next_free;
+            if (b->next_free == nullptr) {
+                m_sl_bitmap[fl] &= ~(std::uint32_t{1} << sl);
+                if (m_sl_bitmap[fl] == 0) {
+                    m_fl_bitmap &= ~(std::uint64_t{1} << fl);
+                }
+            }
+        }
+        if (b->next_free != nullptr) {
+            b->next_free->prev_free = b->prev_free;
+        }
+        m_free_bytes -= block_size(b);
+        --m_free_blocks;
+    }
+
+    /**
+     * @brief Split a free block so its payload starts at an align boundary
+     *
+     * The leading part goes back to the free lists as its own block; the returned
+     * block is free but not listed.
+     */
+    Block* trim_leading(Block* block, size_type align) noexcept {
+        using namespace tlsf_internal;
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(payload(block));
+        std::uintptr_t aligned = stack_alloc_internal::align_up(start, align);
+        if (aligned != start && aligned - start < min_block) {
+            aligned = stack_alloc_internal::align_up(start + min_block, align);
+        }
+        const size_type gap = static_cast<size_type>(aligned - start);
+        if (gap == 0) {
+            return block;
+        }
+
+        Block* rest = reinterpret_cast<Block*>(payload(block) + gap - overhead);
+        rest->prev_phys = block;
+        rest->size = (block_size(block) - gap) | free_bit | prev_free_bit;
+        next_phys(rest)->prev_phys = rest;
+        block->size = (gap - overhead) | (block->size & ~size_mask);
+        insert_free(block);
+        return rest;
+    }
+
+    /// Return the tail of a free, unlisted block beyond size bytes to the free lists
+    void trim_trailing(Block* block, size_type size) noexcept {
+        using namespace tlsf_internal;
+        if (block_size(block) < size + min_block) {
+            return;
+        }
+        Block* rest = reinterpret_cast<Block*>(payload(block) + size);
+        rest->prev_phys = block;
+        rest->size = (block_size(block) - size - overhead) | free_bit;
+        next_phys(rest)->prev_phys = rest;
+        block->size = size | (block->size & ~size_mask);
+        insert_free(rest);
+    }
+
+    /// Start of the borrowed buffer
+    char* m_begin;
+    /// Size of the buffer in bytes
+    size_type m_size;
+    /// Payload bytes of the initial single free block
+    size_type m_pool_size;
+    /// Sum of free block payloads
+    size_type m_free_bytes;
+    /// Number of free blocks
+    size_type m_free_blocks;
+    /// Bit fl set when any list in first level fl is non-empty
+    std::uint64_t m_fl_bitmap;
+    /// Bit sl of entry fl set when list (fl, sl) is non-empty
+    std::uint32_t m_sl_bitmap[tlsf_internal::fl_count];
+    /// Free list heads
+    Block* m_heads[tlsf_internal::fl_count][tlsf_internal::sl_count];
+};
+
+/**
+ * @brief TLSF allocator that holds its own N-byte buffer inline
+ *
+ * @tparam N The size of the buffer in bytes
+ */
+template <std::size_t N>
+class StackTlsfArena : public TlsfResource {
+   public:
+    /** @brief Construct an allocator with the whole inline buffer free */
+    StackTlsfArena() noexcept : TlsfResource(m_buffer, N) {}
+
+   private:
+    /// Inline buffer, aligned to the block granularity
+    alignas(tlsf_internal::granularity) unsigned char m_buffer[N];
+};
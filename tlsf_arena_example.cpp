@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "tlsf_arena.hpp"
+
+int main() {
+    // Example 1: A long-lived map with arbitrary insert/erase order
+    std::cout << "Example 1: Order book nodes recycled in any order\n";
+    StackTlsfArena<64 * 1024> heap;
+    using Alloc = ArenaAllocator<std::pair<const std::uint64_t, double>, TlsfResource>;
+    std::map<std::uint64_t, double, std::less<std::uint64_t>, Alloc> book{Alloc{heap}};
+
+    std::size_t peak = 0;
+    std::uint64_t seed = 12345;
+    for (std::uint64_t tick = 0; tick < 100000; ++tick) {
+        book.emplace(tick, 100.0 + static_cast<double>(tick % 50));
+        if (book.size() > 200) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            auto it = book.lower_bound((seed >> 33) % (tick + 1));  // cancel a random order
+            book.erase(it == book.end() ? book.begin() : it);
+        }
+        if (heap.used() > peak) {
+            peak = heap.used();
+        }
+    }
+    std::cout << book.size() << " live orders after 100000 inserts, peak " << peak << " of "
+              << heap.capacity() << " bytes\n\n";
+
+    // Example 2: Fragmentation stats and coalescing
+    std::cout << "Example 2: Fragmentation\n";
+    StackTlsfArena<16 * 1024> pool;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 64; ++i) {
+        blocks.push_back(pool.allocate(128));
+    }
+    for (std::size_t i = 0; i < blocks.size(); i += 2) {
+        pool.deallocate(blocks[i]);  // free every other block: holes between live ones
+    }
+    std::cout << "Holes: " << pool.free_blocks() << " free blocks, " << pool.free_bytes()
+              << " bytes free, largest " << pool.largest_free_block()
+              << ", fragmentation " << pool.fragmentation() << "\n";
+    for (std::size_t i = 1; i < blocks.size(); i += 2) {
+        pool.deallocate(blocks[i]);  // neighbors merge back into one block
+    }
+    std::cout << "All freed: " << pool.free_blocks() << " free block, fragmentation "
+              << pool.fragmentation() << "\n";
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Compiler-provided type names without RTTI
+ *
+ * Shared by the usage statistics (to label each instantiation) and MappedStackVector
+ * (to fingerprint the element type stored in a file). The text is compiler specific,
+ * so names and hashes are only comparable between builds from the same compiler.
+ */
+namespace type_signature_internal {
+
+/// Compiler-generated signature of this function, which spells out T
+template <typename T>
+constexpr const char* signature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+/**
+ * @brief Extract the type name from a signature() string
+ *
+ * GCC and Clang spell it as "[with T = name]" / "[T = name]"; other signatures (MSVC)
+ * are returned whole.
+ */
+inline std::string_view type_name(const char* sig) noexcept {
+    const std::string_view text{sig};
+    const std::size_t start = text.find("T = ");
+    if (start == std::string_view::npos) {
+        return text;
+    }
+    const std::size_t first = start + 4;
+    const std::size_t last = text.find_first_of(";]", first);
+    return text.substr(first, last == std::string_view::npos ? last : last - first);
+}
+
+/// Name of T as spelled by the compiler
+template <typename T>
+std::string_view type_name() noexcept {
+    return type_name(signature<T>());
+}
+
+/// 64-bit FNV-1a hash of the name of T
+template <typename T>
+std::uint64_t type_hash() noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : type_name<T>()) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+}  // namespace type_signature_internal